@@ -0,0 +1,128 @@
+// Benchmark of the radix sort of translucent draw call keys against std::sort.
+// Built by benchmarks/DrawCallSortBenchmark.vcxproj, or on its own:
+//   g++ -std=c++20 -O2 -Iinclude benchmarks/DrawCallSortBenchmark.cpp
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "RadixSort.hpp"
+
+namespace
+{
+// Same layout as the translucent keys of Rendering.cpp:
+// pass (4) | 1 (1) | inverted depth (19) | material (24) | mesh (16)
+constexpr unsigned int DEPTH_BIT_COUNT{19U};
+constexpr unsigned int DEPTH_SHIFT_COUNT{40U};
+constexpr std::uint64_t DEPTH_MASK{(std::uint64_t{1} << DEPTH_BIT_COUNT) - 1};
+constexpr std::uint64_t TRANSLUCENT_BIT{std::uint64_t{1} << 59};
+constexpr int RUN_COUNT{20};
+
+struct DrawCallKey
+{
+    std::uint32_t index{};
+    std::uint64_t sort_key{};
+};
+
+bool is_draw_call_key_less(const DrawCallKey &key_0, const DrawCallKey &key_1)
+{
+    return key_0.sort_key < key_1.sort_key || (key_0.sort_key == key_1.sort_key && key_0.index < key_1.index);
+}
+
+std::uint64_t quantize_depth(float view_distance)
+{
+    return std::bit_cast<std::uint32_t>(std::max(view_distance, 0.0f)) >> (31U - DEPTH_BIT_COUNT);
+}
+
+// The keys come in state order, with the depth of a random view distance
+std::vector<DrawCallKey> make_keys(std::size_t key_count, float max_view_distance, std::mt19937 &random_engine)
+{
+    std::uniform_int_distribution<std::uint64_t> material_distribution{1, 64};
+    std::uniform_int_distribution<std::uint64_t> mesh_distribution{1, 256};
+    std::uniform_real_distribution<float> view_distance_distribution{0.1f, max_view_distance};
+
+    std::vector<DrawCallKey> keys(key_count);
+    for (std::size_t index{}; index < key_count; ++index)
+    {
+        keys[index] = {
+            .index = static_cast<std::uint32_t>(index),
+            .sort_key = TRANSLUCENT_BIT | material_distribution(random_engine) << 16 | mesh_distribution(random_engine)
+        };
+    }
+    std::sort(keys.begin(), keys.end(), is_draw_call_key_less);
+
+    for (DrawCallKey &key : keys)
+    {
+        std::uint64_t depth{quantize_depth(view_distance_distribution(random_engine))};
+        key.sort_key |= (~depth & DEPTH_MASK) << DEPTH_SHIFT_COUNT;
+    }
+    return keys;
+}
+
+template <typename TSort>
+double measure(const std::vector<DrawCallKey> &keys, std::vector<DrawCallKey> &sorted_keys, TSort sort)
+{
+    double best_duration{1e30};
+    for (int run{}; run < RUN_COUNT; ++run)
+    {
+        sorted_keys = keys;
+        auto start{std::chrono::steady_clock::now()};
+        sort(sorted_keys);
+        std::chrono::duration<double, std::milli> duration{std::chrono::steady_clock::now() - start};
+        best_duration = std::min(best_duration, duration.count());
+    }
+    return best_duration;
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 random_engine{42};
+    std::vector<DrawCallKey> buffer{};
+    std::vector<DrawCallKey> expected_keys{};
+    std::vector<DrawCallKey> sorted_keys{};
+
+    std::printf("keys   | max view distance | std::sort ms | radix sort ms\n");
+    for (std::size_t key_count : {1'000U, 10'000U, 100'000U})
+    {
+        for (float max_view_distance : {1'000.0f, 1e30f})
+        {
+            std::vector<DrawCallKey> keys{make_keys(key_count, max_view_distance, random_engine)};
+            buffer.resize(key_count);
+
+            double std_sort_duration{measure(keys, expected_keys, [](std::vector<DrawCallKey> &keys) {
+                std::sort(keys.begin(), keys.end(), is_draw_call_key_less);
+            })};
+            double radix_sort_duration{measure(keys, sorted_keys, [&](std::vector<DrawCallKey> &keys) {
+                Age::Util::radix_sort(
+                    std::span<DrawCallKey>{keys},
+                    std::span<DrawCallKey>{buffer},
+                    DEPTH_SHIFT_COUNT,
+                    [](const DrawCallKey &key) { return key.sort_key; }
+                );
+            })};
+
+            bool is_sorted{std::equal(
+                sorted_keys.begin(),
+                sorted_keys.end(),
+                expected_keys.begin(),
+                [](const DrawCallKey &key_0, const DrawCallKey &key_1) { return key_0.index == key_1.index; }
+            )};
+            std::printf(
+                "%6zu | %17g | %12.3f | %13.3f%s\n",
+                key_count,
+                max_view_distance,
+                std_sort_duration,
+                radix_sort_duration,
+                is_sorted ? "" : " (wrong order)"
+            );
+        }
+    }
+    return 0;
+}
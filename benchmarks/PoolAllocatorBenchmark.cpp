@@ -0,0 +1,136 @@
+// Contention benchmark of ConcurrentPoolAllocator against a PoolAllocator behind a mutex, with 1, 4 and 16 threads,
+// then of two ConcurrentPoolAllocator instances of the same type used in turn by every thread.
+// Built by benchmarks/PoolAllocatorBenchmark.vcxproj, or on its own:
+//   g++ -std=c++20 -O2 -Iinclude benchmarks/PoolAllocatorBenchmark.cpp src/Memory.cpp src/Logging.cpp src/Time.cpp
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Memory.hpp"
+
+namespace
+{
+constexpr std::size_t PAGE_SIZE{1U << 21};
+constexpr std::size_t CHUNK_SIZE{1U << 14};
+constexpr std::size_t ITERATION_COUNT{200'000};
+// Chunks held at once by every thread, a bit more than two magazines so the depot is used
+constexpr std::size_t LIVE_CHUNK_COUNT{80};
+
+Age::Memory::ConcurrentPoolAllocator<PAGE_SIZE, CHUNK_SIZE> s_concurrent_allocator{};
+Age::Memory::ConcurrentPoolAllocator<PAGE_SIZE, CHUNK_SIZE> s_other_concurrent_allocator{};
+
+std::mutex s_locked_allocator_mutex{};
+Age::Memory::PoolAllocator<PAGE_SIZE, CHUNK_SIZE> s_locked_allocator{};
+
+struct ConcurrentPool
+{
+    static void *get_chunk()
+    {
+        return s_concurrent_allocator.get_chunk();
+    }
+
+    static void return_chunk(void *chunk)
+    {
+        s_concurrent_allocator.return_chunk(chunk);
+    }
+};
+
+// Every other chunk comes from the other instance, so the thread caches of both instances are used in turn.
+// run_thread() returns the chunks in the order it got them, so with an even count of live chunks
+// every chunk goes back to its own instance.
+static_assert(LIVE_CHUNK_COUNT % 2 == 0 && ITERATION_COUNT % 2 == 0);
+
+struct AlternatingConcurrentPools
+{
+    static void *get_chunk()
+    {
+        thread_local std::size_t call_count{};
+        auto &allocator = (call_count++ & 1) == 0 ? s_concurrent_allocator : s_other_concurrent_allocator;
+        return allocator.get_chunk();
+    }
+
+    static void return_chunk(void *chunk)
+    {
+        thread_local std::size_t call_count{};
+        auto &allocator = (call_count++ & 1) == 0 ? s_concurrent_allocator : s_other_concurrent_allocator;
+        allocator.return_chunk(chunk);
+    }
+};
+
+struct LockedPool
+{
+    static void *get_chunk()
+    {
+        std::lock_guard lock{s_locked_allocator_mutex};
+        return s_locked_allocator.get_chunk();
+    }
+
+    static void return_chunk(void *chunk)
+    {
+        std::lock_guard lock{s_locked_allocator_mutex};
+        s_locked_allocator.return_chunk(chunk);
+    }
+};
+
+// Every iteration allocates a chunk and returns the oldest one, after touching them like the ECS would
+template <typename TPool>
+void run_thread()
+{
+    std::vector<void *> chunks(LIVE_CHUNK_COUNT);
+    for (void *&chunk : chunks)
+        chunk = TPool::get_chunk();
+
+    for (std::size_t iteration{}; iteration < ITERATION_COUNT; ++iteration)
+    {
+        std::size_t index{iteration % LIVE_CHUNK_COUNT};
+        TPool::return_chunk(chunks[index]);
+        chunks[index] = TPool::get_chunk();
+        *static_cast<std::size_t *>(chunks[index]) = iteration;
+    }
+
+    for (void *chunk : chunks)
+        TPool::return_chunk(chunk);
+}
+
+template <typename TPool>
+double run(std::size_t thread_count)
+{
+    auto start{std::chrono::steady_clock::now()};
+
+    std::vector<std::thread> threads{};
+    for (std::size_t index{}; index < thread_count; ++index)
+        threads.emplace_back(run_thread<TPool>);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    std::chrono::duration<double, std::nano> duration{std::chrono::steady_clock::now() - start};
+    return duration.count() / static_cast<double>(thread_count * ITERATION_COUNT);
+}
+} // namespace
+
+int main()
+{
+    std::printf("threads | mutex pool ns/op | concurrent pool ns/op\n");
+    for (std::size_t thread_count : {1U, 4U, 16U})
+    {
+        double locked_ns{run<LockedPool>(thread_count)};
+        double concurrent_ns{run<ConcurrentPool>(thread_count)};
+        std::printf("%7zu | %16.1f | %21.1f\n", thread_count, locked_ns, concurrent_ns);
+    }
+
+    std::printf("threads | two concurrent pools ns/op\n");
+    for (std::size_t thread_count : {1U, 4U, 16U})
+        std::printf("%7zu | %26.1f\n", thread_count, run<AlternatingConcurrentPools>(thread_count));
+
+    std::printf(
+        "concurrent pool: %zu pages, %zu used chunks, %zu free chunks\n",
+        s_concurrent_allocator.page_count(),
+        s_concurrent_allocator.used_chunk_count(),
+        s_concurrent_allocator.free_chunk_count()
+    );
+    return 0;
+}
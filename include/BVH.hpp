@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Culling.hpp"
+#include "Vector.hpp"
+
+namespace Age::Gfx
+{
+struct Aabb
+{
+    Math::Vector3 min{std::numeric_limits<float>::infinity()};
+    Math::Vector3 max{-std::numeric_limits<float>::infinity()};
+};
+
+using BvhItemId = std::uint32_t;
+
+inline constexpr BvhItemId INVALID_BVH_ITEM_ID{std::numeric_limits<BvhItemId>::max()};
+
+// Binary tree of bounding spheres stored in depth first order, so each subtree covers a contiguous range of items.
+// Moved items only refit the bounds of their ancestors, the tree is rebuilt with a binned SAH
+// once refits have grown the summed node areas too much or too many items were inserted or removed.
+// Inserted items stay in a linearly tested list until the next build.
+// The updates spread the builds over several frames, the queries use the previous tree until the new one is done.
+class BoundingVolumeHierarchy
+{
+    static constexpr std::uint32_t NO_INDEX{std::numeric_limits<std::uint32_t>::max()};
+
+    struct Node
+    {
+        Aabb bounds{};
+        // 0 for leaves, the left child directly follows its parent
+        std::uint32_t right_child_index{};
+        std::uint32_t item_begin_index{};
+        std::uint32_t item_end_index{};
+    };
+
+    struct Item
+    {
+        Math::Vector3 center{};
+        float radius{};
+        std::uint32_t value{};
+        std::uint32_t leaf_index{NO_INDEX};
+        std::uint32_t tree_item_index{NO_INDEX};
+        // Tells the builds apart the items reusing the id of an item removed meanwhile
+        std::uint32_t generation{};
+        bool is_alive{};
+    };
+
+    // Copies of the item spheres partitioned in place during the builds
+    struct BuildItem
+    {
+        Math::Vector3 center{};
+        float radius{};
+        BvhItemId id{};
+        std::uint32_t generation{};
+    };
+
+    // Range of build items left to split into a node
+    struct BuildTask
+    {
+        std::uint32_t begin_index{};
+        std::uint32_t end_index{};
+        std::uint32_t depth{};
+        std::uint32_t parent_index{};
+        bool is_right_child{};
+    };
+
+    std::vector<Node> _nodes{};
+    std::vector<std::uint32_t> _node_parent_indexes{};
+    std::vector<std::uint64_t> _dirty_node_bits{};
+    bool _has_dirty_nodes{};
+
+    std::vector<Item> _items{};
+    std::vector<BvhItemId> _free_item_ids{};
+    // Item spheres and values in the order of the leaves, removed items get an infinitely negative radius
+    BoundingSpheres _tree_item_spheres{};
+    std::vector<std::uint32_t> _tree_item_values{};
+    std::vector<BuildItem> _build_items{};
+    std::vector<Node> _build_nodes{};
+    std::vector<std::uint32_t> _build_node_parent_indexes{};
+    std::vector<BuildTask> _build_tasks{};
+    bool _is_building{};
+    std::vector<BvhItemId> _pending_item_ids{};
+    std::vector<BvhItemId> _removed_item_ids{};
+
+    // Sum of the node half surface areas, which is proportional to the traversal cost
+    double _built_tree_cost{};
+    double _tree_cost{};
+    float _max_tree_cost_growth{};
+
+    void start_build();
+    // Returns true once all the nodes are built
+    bool continue_build(std::size_t max_item_count);
+    void finish_build();
+    void build_node(const BuildTask &task);
+    void mark_dirty(std::uint32_t node_index);
+    void refit_node(std::uint32_t node_index);
+    void append_tree_items(
+        std::uint32_t begin_index, std::uint32_t end_index, std::vector<std::uint32_t> &values
+    ) const;
+
+  public:
+    explicit BoundingVolumeHierarchy(float max_tree_cost_growth = 1.5f);
+
+    BvhItemId insert_item(const Math::Vector3 &center, float radius, std::uint32_t value);
+    void move_item(BvhItemId id, const Math::Vector3 &center, float radius);
+    void remove_item(BvhItemId id);
+
+    // Refits the moved items and goes on with the build of the next tree, starting one when it is due
+    void update();
+    // Builds the next tree at once
+    void rebuild();
+    void refit();
+
+    // The queries append the values of the matching items
+    void query_frustum(const Frustum &frustum, std::vector<std::uint32_t> &values) const;
+    void query_radius(const Math::Vector3 &center, float radius, std::vector<std::uint32_t> &values) const;
+    void query_ray(
+        const Math::Vector3 &origin,
+        const Math::Vector3 &direction,
+        float max_distance,
+        std::vector<std::uint32_t> &values
+    ) const;
+
+    std::size_t item_count() const
+    {
+        return _items.size() - _free_item_ids.size() - _removed_item_ids.size();
+    }
+
+    std::size_t node_count() const
+    {
+        return _nodes.size();
+    }
+};
+} // namespace Age::Gfx
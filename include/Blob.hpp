@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "ECS.hpp"
+
+namespace Age::Core
+{
+// Blobs hold the variable-length arrays of components outside of the chunks,
+// so components only store a compact handle and stay trivially copyable
+inline constexpr std::size_t BLOB_PAGE_SIZE{1U << 16};
+inline constexpr std::size_t BLOB_ALIGNMENT{16};
+
+// Stores the page index + 1, the in-page offset divided by BLOB_ALIGNMENT and the size class
+enum struct BlobId : std::uint32_t
+{
+};
+
+template <typename T>
+struct Blob
+{
+    BlobId id{};
+    std::uint32_t count{};
+};
+
+// Blobs are allocated from pages in power of two size classes and are all freed with their owner entity
+class BlobArena
+{
+    constexpr static std::size_t SIZE_CLASS_COUNT{13};
+
+    struct BlobHeader
+    {
+        BlobId next_owned_blob_id{};
+        std::uint32_t size{};
+    };
+
+    std::vector<std::byte *> _pages{};
+    std::size_t _page_next_free_offset{BLOB_PAGE_SIZE};
+    std::vector<BlobId> _free_blob_ids[SIZE_CLASS_COUNT]{};
+    // Indexed by entity location index
+    std::vector<BlobId> _entity_first_blob_ids{};
+    std::size_t _used_size{};
+
+    BlobHeader &get_header(BlobId id) const;
+
+  public:
+    BlobArena() = default;
+    BlobArena(const BlobArena &) = delete;
+    BlobArena &operator=(const BlobArena &) = delete;
+    ~BlobArena();
+
+    BlobId allocate(EntityId owner_entity_id, std::size_t size);
+    void free_entity_blobs(EntityId owner_entity_id);
+
+    void *get_data(BlobId id) const;
+
+    std::size_t page_count() const
+    {
+        return _pages.size();
+    }
+
+    std::size_t used_size() const
+    {
+        return _used_size;
+    }
+};
+
+extern BlobArena g_blob_arena;
+
+// The owner can be a reserved entity id, so the blobs are created along with the components referencing them
+template <typename T>
+Blob<T> create_blob(EntityId owner_entity_id, std::span<const T> values)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Blob elements must be trivially copyable");
+    static_assert(alignof(T) <= BLOB_ALIGNMENT, "Blob elements must not be overaligned");
+
+    BlobId id{g_blob_arena.allocate(owner_entity_id, values.size_bytes())};
+    if (id == BlobId{})
+        return {};
+
+    std::memcpy(g_blob_arena.get_data(id), values.data(), values.size_bytes());
+    return {id, static_cast<std::uint32_t>(values.size())};
+}
+
+template <typename T>
+std::span<T> get_blob_data(Blob<T> blob)
+{
+    return {static_cast<T *>(g_blob_arena.get_data(blob.id)), blob.count};
+}
+} // namespace Age::Core
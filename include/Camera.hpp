@@ -65,9 +65,11 @@ struct WindowSpaceCamera
     int viewport_height{};
 };
 
+// The world to view matrix is updated by the renderer before drawing each camera
 struct ProjectionBlock
 {
     Math::Matrix4 view_to_clip_matrix{};
+    Math::Matrix4 world_to_view_matrix{};
 };
 
 struct ProjectionUniformBuffer
@@ -7,8 +7,6 @@ namespace Age::Core
 enum struct ComponentType : std::uint16_t
 {
     TRANSFORM,
-    LOCAL_TO_VIEW_MATRIX,
-    LOCAL_TO_VIEW_NORMAL_MATRIX,
 
     MATERIAL,
 
@@ -31,6 +29,8 @@ enum struct ComponentType : std::uint16_t
 
     CAMERA_RENDER_STATE,
     RENDERER,
+    WORLD_BOUNDS,
+    OCCLUDER,
 
     SPHERICAL_CAMERA,
 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "Mesh.hpp"
+#include "Transform.hpp"
+#include "Vector.hpp"
+
+namespace Age::Gfx
+{
+// World space bounding sphere of a renderer, a negative radius means it is never culled
+struct WorldBounds
+{
+    static constexpr auto TYPE{Core::ComponentType::WORLD_BOUNDS};
+
+    Math::Vector3 center{};
+    float radius{-1.0f};
+};
+
+// Normalized planes pointing inside the frustum, as (normal, distance)
+struct Frustum
+{
+    Math::Vector4 planes[6]{};
+};
+
+// Spheres packed as (center, radius) and transposed four at a time so they are tested together against a plane,
+// the array extends three elements past the last sphere so any range can be loaded by four.
+// Spheres with an infinitely negative radius are never visible.
+class BoundingSpheres
+{
+    std::vector<Math::Vector4> _spheres{};
+    std::size_t _count{};
+
+  public:
+    void reserve(std::size_t count);
+    void resize(std::size_t count);
+    void clear();
+
+    void set(std::size_t index, const Math::Vector3 &center, float radius)
+    {
+        _spheres[index] = {center.x, center.y, center.z, radius};
+    }
+
+    Math::Vector3 center(std::size_t index) const
+    {
+        const Math::Vector4 &sphere{_spheres[index]};
+        return {sphere.x, sphere.y, sphere.z};
+    }
+
+    float radius(std::size_t index) const
+    {
+        return _spheres[index].w;
+    }
+
+    std::size_t size() const
+    {
+        return _count;
+    }
+
+    friend void cull_bounding_spheres(
+        const Frustum &frustum,
+        const BoundingSpheres &spheres,
+        std::size_t begin_index,
+        std::size_t end_index,
+        std::vector<std::uint32_t> &visible_indexes
+    );
+};
+
+Frustum extract_frustum(const Math::Matrix4 &world_to_clip_matrix);
+
+bool is_sphere_visible(const Frustum &frustum, const Math::Vector3 &center, float radius);
+
+void update_world_bounds(const Core::Transform &transform, const MeshRef &mesh, WorldBounds &world_bounds);
+
+// Appends the indexes of the spheres of the range intersecting the frustum in increasing order
+void cull_bounding_spheres(
+    const Frustum &frustum,
+    const BoundingSpheres &spheres,
+    std::size_t begin_index,
+    std::size_t end_index,
+    std::vector<std::uint32_t> &visible_indexes
+);
+} // namespace Age::Gfx
@@ -7,14 +7,18 @@ namespace Age::Gfx
 {
 struct UnlitShader : public Shader
 {
-    UnlitShader(GLuint shader_program);
+    UnlitShader(
+        GLuint shader_program, ShaderCommonUniforms common_uniforms = {.lw_matrix = false, .draw_block = true}
+    );
 };
 
 struct UnlitColorShader : public UnlitShader
 {
     GLint color{-1};
 
-    UnlitColorShader(GLuint shader_program);
+    UnlitColorShader(
+        GLuint shader_program, ShaderCommonUniforms common_uniforms = {.lw_matrix = false, .draw_block = true}
+    );
 };
 
 struct LitDiffuseTextureShader : public Shader
@@ -30,13 +34,17 @@ struct FragmentLightingShader : public Shader
     GLint specular_color{-1};
     GLint surface_shininess{-1};
 
-    FragmentLightingShader(GLuint shader_program);
+    FragmentLightingShader(
+        GLuint shader_program, ShaderCommonUniforms common_uniforms = {.lw_matrix = false, .draw_block = true}
+    );
 };
 
 struct FragmentLightingColorShader : public FragmentLightingShader
 {
     GLint diffuse_color{-1};
 
-    FragmentLightingColorShader(GLuint shader_program);
+    FragmentLightingColorShader(
+        GLuint shader_program, ShaderCommonUniforms common_uniforms = {.lw_matrix = false, .draw_block = true}
+    );
 };
 } // namespace Age::Gfx
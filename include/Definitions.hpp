@@ -1,11 +1,33 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 namespace Age::App
 {
 struct Definitions
 {
     std::size_t component_type_count{};
+    // ECS stats are dumped every N frames when N is not 0
+    std::uint32_t ecs_stats_dump_interval{};
+    // ECS stats are written as JSON to this file when set and logged otherwise
+    std::string_view ecs_stats_dump_path{};
+    // Profile zones are dumped every N frames when N is not 0, in builds defining AGE_PROFILING
+    std::uint32_t profile_dump_interval{};
+    // Profile zones are written as a Chrome trace to this file when set and logged otherwise
+    std::string_view profile_dump_path{};
+    // Render stats of the last N frames are logged every N frames when N is not 0
+    std::uint32_t render_stats_log_interval{};
+    // Indexed triangle meshes are optimized when they are created, their ACMR is logged before and after
+    bool optimize_meshes{};
+    // Renders into an offscreen framebuffer of the given size instead of a window
+    bool headless{};
+    std::uint32_t headless_framebuffer_width{1280};
+    std::uint32_t headless_framebuffer_height{720};
+    // The engine exits after N frames when N is not 0
+    std::uint32_t frame_count{};
+    // Each frame lasts exactly this time when it is not 0, so the scenes update the same way on every run
+    float fixed_delta_time{};
 };
 } // namespace Age::App
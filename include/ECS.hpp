@@ -4,10 +4,12 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <execution>
 #include <functional>
 #include <limits>
 #include <span>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -18,15 +20,33 @@
 
 namespace Age::Core
 {
-inline constexpr std::uint16_t ARCHETYPE_CHUNK_SIZE{1U << 14};
+// Chunks are carved from huge pages to reduce TLB misses when iterating over all entities
+inline constexpr std::size_t CHUNK_PAGE_SIZE{Memory::HUGE_PAGE_SIZE};
+
+enum struct ChunkSizeClass : std::uint8_t
+{
+    SMALL,
+    MEDIUM,
+    LARGE,
+
+    LAST_VALUE
+};
+
+inline constexpr std::size_t CHUNK_SIZES[]{1U << 12, 1U << 14, 1U << 16};
+
+// The smallest chunk size class fitting this many entities is selected for every archetype
+inline constexpr std::size_t MIN_ENTITY_COUNT_PER_CHUNK{64};
 
 using EntityId = std::uint64_t;
 using ArchetypeId = std::uint16_t;
 using ComponentOffset = std::uint16_t;
 
+inline constexpr ArchetypeId INVALID_ARCHETYPE_ID{std::numeric_limits<ArchetypeId>::max()};
+
+// Reserved ids and destroyed entities have an invalid location
 struct EntityLocation
 {
-    ArchetypeId archetype_id{};
+    ArchetypeId archetype_id{INVALID_ARCHETYPE_ID};
     std::uint32_t entity_index{};
 };
 
@@ -35,6 +55,12 @@ struct Archetype
     std::vector<void *> chunks{};
     std::uint32_t entity_count{};
     std::uint16_t entity_count_per_chunk{};
+    std::uint16_t entity_size{};
+    std::uint16_t chunk_padding_size{};
+    ChunkSizeClass chunk_size_class{};
+    std::vector<ComponentType> component_types{};
+    std::vector<std::uint16_t> component_sizes{};
+    std::vector<ComponentOffset> component_offsets{};
 };
 
 struct ArchetypeRef
@@ -43,16 +69,95 @@ struct ArchetypeRef
     Archetype &archetype;
 };
 
-extern Memory::PoolAllocator<1U << 18, ARCHETYPE_CHUNK_SIZE> g_chunk_allocator;
+template <ChunkSizeClass SizeClass>
+using ChunkAllocator =
+    Memory::ConcurrentPoolAllocator<CHUNK_PAGE_SIZE, CHUNK_SIZES[static_cast<std::size_t>(SizeClass)]>;
+
+extern ChunkAllocator<ChunkSizeClass::SMALL> g_small_chunk_allocator;
+extern ChunkAllocator<ChunkSizeClass::MEDIUM> g_medium_chunk_allocator;
+extern ChunkAllocator<ChunkSizeClass::LARGE> g_large_chunk_allocator;
+
+constexpr std::size_t get_chunk_size(ChunkSizeClass size_class)
+{
+    return CHUNK_SIZES[static_cast<std::size_t>(size_class)];
+}
+
+void *allocate_chunk(ChunkSizeClass size_class);
+void free_chunk(ChunkSizeClass size_class, void *chunk);
 
 extern std::vector<Archetype> g_archetypes;
 
 extern std::vector<std::vector<ArchetypeId>> g_component_archetype_ids;
 extern std::vector<std::vector<ComponentOffset>> g_component_archetype_offsets;
 
-extern Util::IdGenerator<EntityId> g_entity_id_generator;
+// Entity ids hold a 32 bits index and a 32 bits generation
+using EntityIdGenerator = Util::ConcurrentIdGenerator<EntityId, 32>;
+
+extern EntityIdGenerator g_entity_id_generator;
 extern std::vector<EntityLocation> g_entity_locations;
 
+// Entity indexes start at 1
+constexpr std::size_t get_entity_location_index(EntityId entity_id)
+{
+    return EntityIdGenerator::index_of(entity_id) - 1;
+}
+
+inline bool is_entity_alive(EntityId entity_id)
+{
+    return g_entity_id_generator.is_alive(entity_id);
+}
+
+// Reserved ids are alive before their entity is created
+inline bool is_entity_created(EntityId entity_id)
+{
+    std::size_t entity_location_index{get_entity_location_index(entity_id)};
+    return is_entity_alive(entity_id) && entity_location_index < g_entity_locations.size() &&
+           g_entity_locations[entity_location_index].archetype_id != INVALID_ARCHETYPE_ID;
+}
+
+// Components can define a static on_destroy(EntityId, TComponent &) function,
+// it is called by destroy_entity() while the entity is still whole and must not create or destroy entities
+template <typename TComponent>
+concept ComponentWithDestroyHook = requires(EntityId entity_id, TComponent &component) {
+    TComponent::on_destroy(entity_id, component);
+};
+
+using ComponentDestroyer = void (*)(EntityId entity_id, void *component);
+
+// Indexed by component type, null for the trivially destructible components without a destroy hook
+extern std::vector<ComponentDestroyer> g_component_destroyers;
+
+template <typename TComponent>
+void destroy_component(EntityId entity_id, void *component)
+{
+    TComponent &typed_component{*static_cast<TComponent *>(component)};
+    if constexpr (ComponentWithDestroyHook<TComponent>)
+        TComponent::on_destroy(entity_id, typed_component);
+    typed_component.~TComponent();
+}
+
+template <typename TComponent>
+void register_component_destroyer()
+{
+    if constexpr (ComponentWithDestroyHook<TComponent> || !std::is_trivially_destructible_v<TComponent>)
+        g_component_destroyers[static_cast<std::size_t>(TComponent::TYPE)] = &destroy_component<TComponent>;
+}
+
+using QueryId = std::uint32_t;
+
+struct QueryCounters
+{
+    std::uint32_t call_count{};
+    std::uint32_t archetype_count{};
+    std::uint64_t entity_count{};
+};
+
+// Indexed by QueryId, reset at the end of every frame
+extern std::vector<QueryCounters> g_query_counters;
+extern std::vector<std::vector<ComponentType>> g_query_component_types;
+
+QueryId register_query(std::span<const ComponentType> component_types);
+
 void init_ecs(const App::Definitions &definitions);
 
 ArchetypeRef get_or_create_archetype(
@@ -65,6 +170,10 @@ Archetype create_archetype(
     std::span<const std::size_t> component_sizes
 );
 
+// Destroys the components, moves the last entity of the archetype into the freed slot
+// and frees the blobs owned by the entity. Reserved ids whose entity was never created are released as well.
+void destroy_entity(EntityId entity_id);
+
 template <std::size_t N>
 struct SortedComponentAttrs
 {
@@ -91,19 +200,23 @@ consteval SortedComponentAttrs<sizeof...(TComponents)> get_sorted_component_attr
     return sorted_attrs;
 }
 
+// Returns false when no chunk could be allocated for the entity
 template <typename... TComponents, std::size_t... IS>
-EntityId add_entity_to_archetype(
-    ArchetypeId archetype_id, Archetype &archetype, const TComponents &...components, std::index_sequence<IS...>
+bool add_entity_to_archetype(
+    EntityId entity_id,
+    ArchetypeId archetype_id,
+    Archetype &archetype,
+    const TComponents &...components,
+    std::index_sequence<IS...>
 )
 {
-    EntityId entity_id{g_entity_id_generator.generate()};
     std::uint32_t entity_index{archetype.entity_count % archetype.entity_count_per_chunk};
 
-    void *chunk{};
+    void *chunk{entity_index == 0 ? allocate_chunk(archetype.chunk_size_class) : archetype.chunks.back()};
+    if (chunk == nullptr)
+        return false;
     if (entity_index == 0)
-        chunk = archetype.chunks.emplace_back(g_chunk_allocator.get_chunk());
-    else
-        chunk = archetype.chunks.back();
+        archetype.chunks.push_back(chunk);
 
     EntityId *entity_id_array{static_cast<EntityId *>(chunk)};
     entity_id_array[entity_index] = entity_id;
@@ -123,31 +236,71 @@ EntityId add_entity_to_archetype(
         static_cast<char *>(chunk) + cmpt_offsets[IS] + entity_index * sizeof(TComponents)...
     };
     (new (cmpt_ptrs[IS]) TComponents{components}, ...);
+    (register_component_destroyer<TComponents>(), ...);
 
     ++archetype.entity_count;
 
-    if (entity_id - 1 == g_entity_locations.size())
-        g_entity_locations.emplace_back(archetype_id, entity_index);
-    else
-        g_entity_locations[entity_id - 1] = {archetype_id, entity_index};
+    // Reserved entity ids can be created after the ids generated later
+    std::size_t entity_location_index{get_entity_location_index(entity_id)};
+    if (entity_location_index >= g_entity_locations.size())
+        g_entity_locations.resize(entity_location_index + 1);
+    g_entity_locations[entity_location_index] = {archetype_id, archetype.entity_count - 1};
+    return true;
+}
 
-    return entity_id;
+// Entities whose components own blobs need their id before their components exist,
+// the reserved id is then given to create_reserved_entity()
+inline EntityId reserve_entity_id()
+{
+    return g_entity_id_generator.generate();
 }
 
 template <typename... TComponents>
-EntityId create_entity(const TComponents &...components)
+EntityId create_reserved_entity(EntityId entity_id, const TComponents &...components)
 {
+    // The id generator returns a null id once it runs out of slots
+    if (entity_id == EntityId{})
+        return entity_id;
+
     constexpr static auto sorted_attrs = get_sorted_component_attrs<TComponents...>();
     ArchetypeRef archetype_ref{get_or_create_archetype(sorted_attrs.component_types, sorted_attrs.component_sizes)};
-    return add_entity_to_archetype<TComponents...>(
-        archetype_ref.archetype_id, archetype_ref.archetype, components..., std::index_sequence_for<TComponents...>{}
-    );
+    bool is_added{add_entity_to_archetype<TComponents...>(
+        entity_id,
+        archetype_ref.archetype_id,
+        archetype_ref.archetype,
+        components...,
+        std::index_sequence_for<TComponents...>{}
+    )};
+    if (!is_added)
+    {
+        // Also releases the id and the blobs already owned by the entity
+        destroy_entity(entity_id);
+        return EntityId{};
+    }
+    return entity_id;
+}
+
+template <typename... TComponents>
+EntityId create_entity(const TComponents &...components)
+{
+    return create_reserved_entity(reserve_entity_id(), components...);
+}
+
+template <typename TComponent>
+bool has_entity_component(EntityId entity_id)
+{
+    const EntityLocation &entity_location{g_entity_locations[get_entity_location_index(entity_id)]};
+    const std::vector<ArchetypeId> &cmpt_archetype_ids{
+        g_component_archetype_ids[static_cast<std::size_t>(TComponent::TYPE)]
+    };
+    return std::find(cmpt_archetype_ids.cbegin(), cmpt_archetype_ids.cend(), entity_location.archetype_id) !=
+           cmpt_archetype_ids.cend();
 }
 
 template <typename TComponent>
 TComponent &get_entity_component(EntityId entity_id)
 {
-    const EntityLocation &entity_location{g_entity_locations[entity_id - 1]};
+    const EntityLocation &entity_location{g_entity_locations[get_entity_location_index(entity_id)]};
     Archetype &archetype{g_archetypes[entity_location.archetype_id]};
     std::size_t chunk_index{entity_location.entity_index / archetype.entity_count_per_chunk};
     std::size_t chunk_entity_index{entity_location.entity_index % archetype.entity_count_per_chunk};
@@ -170,7 +323,7 @@ TComponent &get_entity_component(EntityId entity_id)
 template <typename... TComponents, std::size_t... IS>
 std::tuple<TComponents &...> get_entity_components_impl(EntityId entity_id, std::index_sequence<IS...>)
 {
-    const EntityLocation &entity_location{g_entity_locations[entity_id - 1]};
+    const EntityLocation &entity_location{g_entity_locations[get_entity_location_index(entity_id)]};
     Archetype &archetype{g_archetypes[entity_location.archetype_id]};
     std::size_t chunk_index{entity_location.entity_index / archetype.entity_count_per_chunk};
     std::size_t chunk_entity_index{entity_location.entity_index % archetype.entity_count_per_chunk};
@@ -203,6 +356,11 @@ void process_components_impl(
     std::function<void(TComponents &...)> system_function, std::index_sequence<ISLess1...>, std::index_sequence<IS...>
 )
 {
+    static const QueryId query_id{
+        register_query(std::array<ComponentType, sizeof...(TComponents)>{TComponents::TYPE...})
+    };
+    QueryCounters query_counters{.call_count = 1};
+
     std::array<const std::vector<ArchetypeId> *, sizeof...(TComponents)> component_archetype_ids{
         &g_component_archetype_ids[static_cast<std::size_t>(TComponents::TYPE)]...
     };
@@ -221,6 +379,9 @@ void process_components_impl(
             const Archetype &archetype{g_archetypes[archetype_ids[0]]};
             std::size_t entity_index{};
 
+            ++query_counters.archetype_count;
+            query_counters.entity_count += archetype.entity_count;
+
             for (decltype(archetype.chunks)::size_type chunk_index{}; chunk_index < archetype.chunks.size();
                  ++chunk_index)
             {
@@ -252,6 +413,11 @@ void process_components_impl(
             }
         }
     }
+
+    QueryCounters &counters{g_query_counters[query_id]};
+    counters.call_count += query_counters.call_count;
+    counters.archetype_count += query_counters.archetype_count;
+    counters.entity_count += query_counters.entity_count;
 }
 
 template <typename... TComponents>
@@ -274,6 +440,115 @@ void process_components(void (*system_function)(TComponents &...))
     );
 }
 
+template <typename... TComponents, std::size_t... ISLess1, std::size_t... IS>
+void process_components_in_parallel_impl(
+    std::function<void(TComponents &...)> system_function, std::index_sequence<ISLess1...>, std::index_sequence<IS...>
+)
+{
+    struct ChunkRange
+    {
+        char *chunk_ptr{};
+        std::size_t entity_count{};
+        std::array<ComponentOffset, sizeof...(TComponents)> component_offsets{};
+    };
+
+    static const QueryId query_id{
+        register_query(std::array<ComponentType, sizeof...(TComponents)>{TComponents::TYPE...})
+    };
+    QueryCounters query_counters{.call_count = 1};
+
+    std::array<const std::vector<ArchetypeId> *, sizeof...(TComponents)> component_archetype_ids{
+        &g_component_archetype_ids[static_cast<std::size_t>(TComponents::TYPE)]...
+    };
+
+    std::array<std::size_t, sizeof...(TComponents)> component_archetype_indexes{};
+    std::array<std::size_t, sizeof...(TComponents)> component_archetype_counts{component_archetype_ids[IS]->size()...};
+
+    std::vector<ChunkRange> chunk_ranges{};
+    while (((component_archetype_indexes[IS] < component_archetype_counts[IS]) && ...))
+    {
+        std::array<ArchetypeId, sizeof...(TComponents)> archetype_ids{
+            (*component_archetype_ids[IS])[component_archetype_indexes[IS]]...
+        };
+
+        if (((archetype_ids[0] == archetype_ids[ISLess1 + 1]) && ...))
+        {
+            const Archetype &archetype{g_archetypes[archetype_ids[0]]};
+            std::size_t entity_index{};
+
+            ++query_counters.archetype_count;
+            query_counters.entity_count += archetype.entity_count;
+
+            std::array<ComponentOffset, sizeof...(TComponents)> component_offsets{
+                g_component_archetype_offsets[static_cast<std::size_t>(TComponents::TYPE)]
+                                             [component_archetype_indexes[IS]]...
+            };
+
+            for (std::size_t chunk_index{};
+                 chunk_index < archetype.chunks.size() && entity_index < archetype.entity_count;
+                 ++chunk_index)
+            {
+                std::size_t entity_count{
+                    std::min<std::size_t>(archetype.entity_count_per_chunk, archetype.entity_count - entity_index)
+                };
+                chunk_ranges.push_back({
+                    .chunk_ptr = static_cast<char *>(archetype.chunks[chunk_index]),
+                    .entity_count = entity_count,
+                    .component_offsets = component_offsets
+                });
+                entity_index += entity_count;
+            }
+
+            (component_archetype_indexes[IS]++, ...);
+        }
+        else
+        {
+            for (std::size_t index{}; index < sizeof...(TComponents); ++index)
+            {
+                component_archetype_indexes[index] += ((archetype_ids[index] <= archetype_ids[IS]) && ...);
+            }
+        }
+    }
+
+    std::for_each(std::execution::par, chunk_ranges.begin(), chunk_ranges.end(), [&](const ChunkRange &chunk_range) {
+        for (std::size_t chunk_entity_index{}; chunk_entity_index < chunk_range.entity_count; ++chunk_entity_index)
+        {
+            system_function(
+                static_cast<TComponents *>(
+                    static_cast<void *>(chunk_range.chunk_ptr + chunk_range.component_offsets[IS])
+                )[chunk_entity_index]...
+            );
+        }
+    });
+
+    QueryCounters &counters{g_query_counters[query_id]};
+    counters.call_count += query_counters.call_count;
+    counters.archetype_count += query_counters.archetype_count;
+    counters.entity_count += query_counters.entity_count;
+}
+
+// The chunks are processed concurrently,
+// so the system function must not write to anything shared between entities
+template <typename... TComponents>
+void process_components_in_parallel(std::function<void(TComponents &...)> system_function)
+{
+    process_components_in_parallel_impl<TComponents...>(
+        system_function,
+        std::make_index_sequence<sizeof...(TComponents) - 1>{},
+        std::index_sequence_for<TComponents...>{}
+    );
+}
+
+template <typename... TComponents>
+void process_components_in_parallel(void (*system_function)(TComponents &...))
+{
+    process_components_in_parallel_impl<TComponents...>(
+        std::function{system_function},
+        std::make_index_sequence<sizeof...(TComponents) - 1>{},
+        std::index_sequence_for<TComponents...>{}
+    );
+}
+
 template <typename... TComponents, std::size_t... ISLess1, std::size_t... IS>
 void process_components_impl(
     std::function<void(EntityId, TComponents &...)> system_function,
@@ -281,6 +556,11 @@ void process_components_impl(
     std::index_sequence<IS...>
 )
 {
+    static const QueryId query_id{
+        register_query(std::array<ComponentType, sizeof...(TComponents)>{TComponents::TYPE...})
+    };
+    QueryCounters query_counters{.call_count = 1};
+
     std::array<const std::vector<ArchetypeId> *, sizeof...(TComponents)> component_archetype_ids{
         &g_component_archetype_ids[static_cast<std::size_t>(TComponents::TYPE)]...
     };
@@ -299,6 +579,9 @@ void process_components_impl(
             const Archetype &archetype{g_archetypes[archetype_ids[0]]};
             std::size_t entity_index{};
 
+            ++query_counters.archetype_count;
+            query_counters.entity_count += archetype.entity_count;
+
             for (decltype(archetype.chunks)::size_type chunk_index{}; chunk_index < archetype.chunks.size();
                  ++chunk_index)
             {
@@ -331,6 +614,11 @@ void process_components_impl(
             }
         }
     }
+
+    QueryCounters &counters{g_query_counters[query_id]};
+    counters.call_count += query_counters.call_count;
+    counters.archetype_count += query_counters.archetype_count;
+    counters.entity_count += query_counters.entity_count;
 }
 
 template <typename... TComponents>
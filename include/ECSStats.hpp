@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Definitions.hpp"
+#include "ECS.hpp"
+
+namespace Age::Core
+{
+struct ArchetypeStats
+{
+    ArchetypeId archetype_id{};
+    std::span<const ComponentType> component_types{};
+    std::uint32_t entity_count{};
+    std::uint32_t chunk_count{};
+    std::size_t chunk_size{};
+    std::uint16_t entity_count_per_chunk{};
+    std::uint16_t entity_size{};
+    // Bytes lost in every chunk to the alignment of the component arrays
+    std::size_t chunk_padding_size{};
+    // Bytes left unused at the end of every chunk
+    std::size_t chunk_tail_size{};
+    // Used entity slots over the entity slots of the allocated chunks
+    float fill_ratio{};
+};
+
+struct ChunkAllocatorStats
+{
+    std::size_t page_size{};
+    std::size_t chunk_size{};
+    std::size_t page_count{};
+    std::size_t used_chunk_count{};
+    std::size_t free_chunk_count{};
+};
+
+struct QueryStats
+{
+    QueryId query_id{};
+    std::span<const ComponentType> component_types{};
+    QueryCounters counters{};
+};
+
+struct EcsStats
+{
+    std::uint64_t frame_index{};
+    std::vector<ArchetypeStats> archetypes{};
+    std::vector<QueryStats> queries{};
+    // One per chunk size class
+    std::vector<ChunkAllocatorStats> chunk_allocators{};
+    std::uint64_t entity_count{};
+    std::uint64_t generated_entity_id_count{};
+    std::size_t free_entity_id_count{};
+    // Bytes of the allocated chunks holding entity data
+    std::size_t used_chunk_size{};
+    // Bytes of the allocated chunks lost to padding, chunk tails and empty entity slots
+    std::size_t wasted_chunk_size{};
+    float fill_ratio{};
+};
+
+void init_ecs_stats(const App::Definitions &definitions);
+
+// The query counters are the ones of the last completed frame
+EcsStats get_ecs_stats();
+
+void log_ecs_stats(const EcsStats &stats);
+bool write_ecs_stats(const EcsStats &stats, std::string_view file_path);
+
+// Must be called once at the end of every frame
+void update_ecs_stats();
+} // namespace Age::Core
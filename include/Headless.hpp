@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Age::Gfx
+{
+// Builds defining AGE_HEADLESS_EGL can render without any window or display server,
+// through an OpenGL 3.3 context created by EGL (surfaceless Mesa or pbuffer) and loaded into glad.
+// The frames are drawn into an offscreen framebuffer which stays bound until the context is destroyed.
+// Builds defining AGE_RECORDING_OGL load the recording functions instead and create no context at all.
+bool create_headless_context(unsigned int framebuffer_width, unsigned int framebuffer_height);
+void destroy_headless_context();
+
+// Waits for the GPU to complete the frame, so the frame times include the driver work
+void finish_headless_frame();
+} // namespace Age::Gfx
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
+#include "ErrorHandling.hpp"
 #include "Utils.hpp"
 
 namespace Age::Util
@@ -47,5 +53,189 @@ class IdGenerator
     {
         _free_ids.emplace_back(id);
     }
+
+    T next_id() const
+    {
+        return _next_id;
+    }
+
+    std::size_t free_id_count() const
+    {
+        return _free_ids.size();
+    }
+};
+
+// Thread safe id generator.
+// Ids store the index of their slot in their low IndexBits bits and the generation of their slot in the
+// remaining bits. Destroying an id increments the generation of its slot, which makes stale ids detectable.
+// Free slots are kept in a lock-free stack whose head is tagged to avoid the ABA problem.
+// Slots live in pages allocated on first use, each page twice as large as the previous one.
+template <typename T, unsigned int IndexBits = sizeof(T) * 4>
+class ConcurrentIdGenerator
+{
+    using Value = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+
+    static_assert(std::is_unsigned_v<Value>, "Ids must be unsigned");
+    static_assert(IndexBits < sizeof(Value) * 8, "Ids need generation bits");
+    static_assert(IndexBits <= 32, "Slot indexes are limited to 32 bits");
+
+    constexpr static Value INDEX_MASK{static_cast<Value>((Value{1} << IndexBits) - 1)};
+    constexpr static Value GENERATION_MASK{static_cast<Value>(~Value{} >> IndexBits)};
+    constexpr static std::uint64_t NULL_SLOT{0};
+
+    constexpr static unsigned int FIRST_PAGE_BITS{IndexBits < 10 ? IndexBits : 10};
+    constexpr static std::size_t PAGE_COUNT{IndexBits - FIRST_PAGE_BITS + 1};
+
+    struct Slot
+    {
+        std::atomic<std::uint32_t> next_free_slot{};
+        std::atomic<Value> generation{};
+    };
+
+    std::atomic<std::size_t> _next_index{};
+    std::atomic<std::size_t> _free_id_count{};
+    // Tag in the high 32 bits, index + 1 of the top slot in the low 32 bits
+    std::atomic<std::uint64_t> _free_slots_head{};
+    std::atomic<Slot *> _pages[PAGE_COUNT]{};
+
+    static constexpr T make_id(std::size_t index, Value generation)
+    {
+        return static_cast<T>(static_cast<Value>(generation << IndexBits) | static_cast<Value>(index));
+    }
+
+    // Page p holds 2^(p + FIRST_PAGE_BITS) slots, starting at the index 2^(p + FIRST_PAGE_BITS) - 2^FIRST_PAGE_BITS
+    static constexpr std::size_t page_of(std::size_t index)
+    {
+        return std::bit_width(index + (std::size_t{1} << FIRST_PAGE_BITS)) - 1 - FIRST_PAGE_BITS;
+    }
+
+    static constexpr std::size_t page_offset_of(std::size_t index, std::size_t page)
+    {
+        return index + (std::size_t{1} << FIRST_PAGE_BITS) - (std::size_t{1} << (page + FIRST_PAGE_BITS));
+    }
+
+    // Null when the page of the slot is not allocated yet
+    Slot *find_slot(std::size_t index) const
+    {
+        std::size_t page{page_of(index)};
+        Slot *slots{_pages[page].load(std::memory_order_acquire)};
+        return slots ? slots + page_offset_of(index, page) : nullptr;
+    }
+
+    Slot &get_or_allocate_slot(std::size_t index)
+    {
+        std::size_t page{page_of(index)};
+        Slot *slots{_pages[page].load(std::memory_order_acquire)};
+        if (!slots)
+        {
+            Slot *new_slots{new Slot[std::size_t{1} << (page + FIRST_PAGE_BITS)]{}};
+            if (_pages[page].compare_exchange_strong(
+                    slots, new_slots, std::memory_order_acq_rel, std::memory_order_acquire
+                ))
+                slots = new_slots;
+            else
+                delete[] new_slots;
+        }
+        return slots[page_offset_of(index, page)];
+    }
+
+  public:
+    ConcurrentIdGenerator(T first_id)
+        : _next_index{index_of(first_id)}
+    {
+    }
+
+    ~ConcurrentIdGenerator()
+    {
+        for (std::atomic<Slot *> &page : _pages)
+            delete[] page.load(std::memory_order_relaxed);
+    }
+
+    ConcurrentIdGenerator(const ConcurrentIdGenerator &) = delete;
+    ConcurrentIdGenerator &operator=(const ConcurrentIdGenerator &) = delete;
+
+    static constexpr std::size_t index_of(T id)
+    {
+        return static_cast<std::size_t>(static_cast<Value>(id) & INDEX_MASK);
+    }
+
+    static constexpr Value generation_of(T id)
+    {
+        return static_cast<Value>(static_cast<Value>(id) >> IndexBits);
+    }
+
+    // Returns T{} once all the slot indexes are used
+    T generate()
+    {
+        std::uint64_t head{_free_slots_head.load(std::memory_order_acquire)};
+        while ((head & 0xFFFFFFFFU) != NULL_SLOT)
+        {
+            std::size_t index{static_cast<std::size_t>((head & 0xFFFFFFFFU) - 1)};
+            Slot &slot{*find_slot(index)};
+            std::uint64_t next_head{((head >> 32) + 1) << 32 | slot.next_free_slot.load(std::memory_order_relaxed)};
+
+            if (_free_slots_head.compare_exchange_weak(
+                    head, next_head, std::memory_order_acquire, std::memory_order_acquire
+                ))
+            {
+                _free_id_count.fetch_sub(1, std::memory_order_relaxed);
+                return make_id(index, slot.generation.load(std::memory_order_relaxed));
+            }
+        }
+
+        std::size_t index{_next_index.fetch_add(1, std::memory_order_relaxed)};
+        // The last index is left out as the free slot stack stores index + 1 in 32 bits
+        VBAIL_ERROR_IF(index >= INDEX_MASK, T{}, "Id generator ran out of its {} slot indexes", INDEX_MASK);
+
+        get_or_allocate_slot(index);
+        return make_id(index, 0);
+    }
+
+    // Stale ids are rejected, so destroying an id twice leaves its slot untouched
+    void destroy(T id)
+    {
+        std::size_t index{index_of(id)};
+        Slot *slot{index < _next_index.load(std::memory_order_relaxed) ? find_slot(index) : nullptr};
+        BAIL_ERROR_IF(!slot, "Destroyed id {} was never generated", static_cast<Value>(id));
+
+        Value generation{generation_of(id)};
+        BAIL_ERROR_IF(
+            !slot->generation.compare_exchange_strong(
+                generation, (generation + 1) & GENERATION_MASK, std::memory_order_relaxed
+            ),
+            "Destroyed id {} is stale",
+            static_cast<Value>(id)
+        );
+
+        std::uint64_t head{_free_slots_head.load(std::memory_order_relaxed)};
+        std::uint64_t next_head{};
+        do
+        {
+            slot->next_free_slot.store(static_cast<std::uint32_t>(head & 0xFFFFFFFFU), std::memory_order_relaxed);
+            next_head = ((head >> 32) + 1) << 32 | (index + 1);
+        } while (!_free_slots_head.compare_exchange_weak(
+            head, next_head, std::memory_order_release, std::memory_order_relaxed
+        ));
+
+        _free_id_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Ids destroyed or never generated are not alive
+    bool is_alive(T id) const
+    {
+        std::size_t index{index_of(id)};
+        const Slot *slot{index < _next_index.load(std::memory_order_relaxed) ? find_slot(index) : nullptr};
+        return slot && slot->generation.load(std::memory_order_relaxed) == generation_of(id);
+    }
+
+    T next_id() const
+    {
+        return make_id(_next_index.load(std::memory_order_relaxed), 0);
+    }
+
+    std::size_t free_id_count() const
+    {
+        return _free_id_count.load(std::memory_order_relaxed);
+    }
 };
 } // namespace Age::Util
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Age::Memory
@@ -11,6 +15,13 @@ constexpr std::size_t padding_to(std::size_t size)
     return (N - size % N) % N;
 }
 
+inline constexpr std::size_t HUGE_PAGE_SIZE{1U << 21};
+
+// Allocates zeroed pages straight from the OS, backing them with huge pages when asked and possible.
+// Returns nullptr when the OS is out of memory, so do the chunk getters of the pool allocators
+void *allocate_pages(std::size_t size, bool use_huge_pages);
+void free_pages(void *pages, std::size_t size);
+
 template <std::size_t AllocSize, std::size_t ChunkSize>
 class PoolAllocator
 {
@@ -19,16 +30,28 @@ class PoolAllocator
 
     constexpr static std::size_t CHUNK_COUNT_PER_PAGE{AllocSize / ChunkSize};
 
-    std::byte *_last_allocated_page{nullptr};
+    bool _use_huge_pages{};
+    std::vector<std::byte *> _pages{};
     std::size_t _page_next_free_chunk_index{};
     std::vector<void *> _returned_chunks{};
 
   public:
-    PoolAllocator()
+    PoolAllocator(bool use_huge_pages = false)
+        : _use_huge_pages{use_huge_pages}
     {
+        _pages.reserve(16);
         _returned_chunks.reserve(16);
     }
 
+    PoolAllocator(const PoolAllocator &) = delete;
+    PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+    ~PoolAllocator()
+    {
+        for (std::byte *page : _pages)
+            free_pages(page, AllocSize);
+    }
+
     void *get_chunk()
     {
         if (_returned_chunks.size() > 0)
@@ -38,18 +61,304 @@ class PoolAllocator
             return chunk;
         }
 
-        if (_last_allocated_page == nullptr || _page_next_free_chunk_index == CHUNK_COUNT_PER_PAGE)
+        if (_pages.empty() || _page_next_free_chunk_index == CHUNK_COUNT_PER_PAGE)
         {
-            _last_allocated_page = new std::byte[AllocSize];
+            auto *page = static_cast<std::byte *>(allocate_pages(AllocSize, _use_huge_pages));
+            if (page == nullptr)
+                return nullptr;
+
+            _pages.emplace_back(page);
             _page_next_free_chunk_index = 0;
         }
 
-        return &_last_allocated_page[_page_next_free_chunk_index++ * ChunkSize];
+        return &_pages.back()[_page_next_free_chunk_index++ * ChunkSize];
     }
 
     void return_chunk(void *chunk_ptr)
     {
         _returned_chunks.emplace_back(chunk_ptr);
     }
+
+    static constexpr std::size_t chunk_size()
+    {
+        return ChunkSize;
+    }
+
+    static constexpr std::size_t page_size()
+    {
+        return AllocSize;
+    }
+
+    std::size_t page_count() const
+    {
+        return _pages.size();
+    }
+
+    // Chunks that were returned and are waiting to be reused
+    std::size_t free_chunk_count() const
+    {
+        return _returned_chunks.size();
+    }
+
+    // Chunks currently handed out to callers
+    std::size_t used_chunk_count() const
+    {
+        std::size_t carved_chunk_count{
+            _pages.empty() ? 0 : (_pages.size() - 1) * CHUNK_COUNT_PER_PAGE + _page_next_free_chunk_index
+        };
+        return carved_chunk_count - _returned_chunks.size();
+    }
+};
+
+// Thread safe variant of PoolAllocator.
+// Every thread keeps a cache of free chunks and exchanges them in batches of MAGAZINE_SIZE chunks with a shared depot,
+// so the depot lock is only taken once every MAGAZINE_SIZE allocations or returns.
+// Every thread keeps one cache per instance, an instance must only be destroyed once no thread uses it anymore.
+template <std::size_t AllocSize, std::size_t ChunkSize>
+class ConcurrentPoolAllocator
+{
+    static_assert(ChunkSize <= AllocSize, "ChunkSize must be less than or equal to AllocSize");
+    static_assert(AllocSize % ChunkSize == 0, "AllocSize must be divisible by ChunkSize");
+
+    constexpr static std::size_t CHUNK_COUNT_PER_PAGE{AllocSize / ChunkSize};
+
+  public:
+    constexpr static std::size_t MAGAZINE_SIZE{std::min<std::size_t>(32, CHUNK_COUNT_PER_PAGE)};
+
+  private:
+    struct PageNode
+    {
+        std::byte *page{};
+        PageNode *next{};
+    };
+
+    struct ThreadCache
+    {
+        // Null once flushed, the cache is then reused for the next instance the thread uses
+        std::atomic<ConcurrentPoolAllocator *> allocator{};
+        // Only written by the owning thread, atomic so the stats can read it
+        std::atomic<std::size_t> chunk_count{};
+        void *chunks[MAGAZINE_SIZE * 2]{};
+    };
+
+    // The caches of a thread for all the instances of the type, a thread only uses a few instances
+    // so they are searched linearly
+    struct ThreadCaches
+    {
+        std::vector<std::unique_ptr<ThreadCache>> caches{};
+
+        ~ThreadCaches()
+        {
+            for (const std::unique_ptr<ThreadCache> &cache : caches)
+            {
+                ConcurrentPoolAllocator *allocator{cache->allocator.load(std::memory_order_acquire)};
+                if (allocator != nullptr)
+                    allocator->flush(*cache);
+            }
+        }
+    };
+
+    bool _use_huge_pages{};
+    std::atomic<PageNode *> _pages{};
+    std::atomic<std::size_t> _page_count{};
+
+    // Guards the depot and the thread cache list
+    std::mutex _depot_mutex{};
+    std::vector<void *> _depot_chunks{};
+    std::vector<ThreadCache *> _thread_caches{};
+
+    ThreadCache &thread_cache()
+    {
+        thread_local ThreadCaches thread_caches{};
+
+        ThreadCache *free_cache{};
+        for (const std::unique_ptr<ThreadCache> &cache : thread_caches.caches)
+        {
+            ConcurrentPoolAllocator *allocator{cache->allocator.load(std::memory_order_relaxed)};
+            if (allocator == this)
+                return *cache;
+            if (allocator == nullptr)
+                free_cache = cache.get();
+        }
+
+        if (free_cache == nullptr)
+            free_cache = thread_caches.caches.emplace_back(std::make_unique<ThreadCache>()).get();
+
+        std::lock_guard lock{_depot_mutex};
+        free_cache->allocator.store(this, std::memory_order_relaxed);
+        free_cache->chunk_count.store(0, std::memory_order_relaxed);
+        _thread_caches.emplace_back(free_cache);
+        return *free_cache;
+    }
+
+    std::byte *allocate_page()
+    {
+        auto *page = static_cast<std::byte *>(allocate_pages(AllocSize, _use_huge_pages));
+        if (page == nullptr)
+            return nullptr;
+
+        auto *node = new PageNode{.page = page, .next = _pages.load(std::memory_order_relaxed)};
+        while (!_pages.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        _page_count.fetch_add(1, std::memory_order_relaxed);
+
+        return page;
+    }
+
+    // Returns the new chunk count of the cache, 0 when no page could be allocated
+    std::size_t refill(ThreadCache &cache)
+    {
+        {
+            std::lock_guard lock{_depot_mutex};
+            if (!_depot_chunks.empty())
+            {
+                // A partial batch is taken as well, rather than carving a new page
+                std::size_t chunk_count{std::min(_depot_chunks.size(), MAGAZINE_SIZE)};
+                auto batch_start = _depot_chunks.end() - static_cast<std::ptrdiff_t>(chunk_count);
+                std::copy(batch_start, _depot_chunks.end(), cache.chunks);
+                _depot_chunks.erase(batch_start, _depot_chunks.end());
+                cache.chunk_count.store(chunk_count, std::memory_order_relaxed);
+                return chunk_count;
+            }
+        }
+
+        // Carve a whole page outside of the lock, keep a magazine of it and give the rest to the depot
+        std::byte *page{allocate_page()};
+        if (page == nullptr)
+            return 0;
+
+        for (std::size_t index{}; index < MAGAZINE_SIZE; ++index)
+            cache.chunks[index] = &page[index * ChunkSize];
+
+        std::lock_guard lock{_depot_mutex};
+        cache.chunk_count.store(MAGAZINE_SIZE, std::memory_order_relaxed);
+        if constexpr (CHUNK_COUNT_PER_PAGE > MAGAZINE_SIZE)
+        {
+            for (std::size_t index{MAGAZINE_SIZE}; index < CHUNK_COUNT_PER_PAGE; ++index)
+                _depot_chunks.emplace_back(&page[index * ChunkSize]);
+        }
+        return MAGAZINE_SIZE;
+    }
+
+    // Moves the last chunk_count chunks of the cache to the depot, the depot lock must be held
+    void drain_locked(ThreadCache &cache, std::size_t chunk_count)
+    {
+        std::size_t cache_chunk_count{cache.chunk_count.load(std::memory_order_relaxed)};
+        _depot_chunks.insert(
+            _depot_chunks.end(), &cache.chunks[cache_chunk_count - chunk_count], &cache.chunks[cache_chunk_count]
+        );
+        cache.chunk_count.store(cache_chunk_count - chunk_count, std::memory_order_relaxed);
+    }
+
+    void flush(ThreadCache &cache)
+    {
+        std::lock_guard lock{_depot_mutex};
+        drain_locked(cache, cache.chunk_count.load(std::memory_order_relaxed));
+        std::erase(_thread_caches, &cache);
+        cache.allocator.store(nullptr, std::memory_order_release);
+    }
+
+  public:
+    ConcurrentPoolAllocator(bool use_huge_pages = false)
+        : _use_huge_pages{use_huge_pages}
+    {
+        _depot_chunks.reserve(CHUNK_COUNT_PER_PAGE * 4);
+    }
+
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator &) = delete;
+    ConcurrentPoolAllocator &operator=(const ConcurrentPoolAllocator &) = delete;
+
+    ~ConcurrentPoolAllocator()
+    {
+        // The cached chunks belong to the freed pages, the caches are left empty for other instances
+        {
+            std::lock_guard lock{_depot_mutex};
+            for (ThreadCache *cache : _thread_caches)
+            {
+                cache->chunk_count.store(0, std::memory_order_relaxed);
+                cache->allocator.store(nullptr, std::memory_order_release);
+            }
+        }
+
+        PageNode *node{_pages.load(std::memory_order_acquire)};
+        while (node != nullptr)
+        {
+            PageNode *next{node->next};
+            free_pages(node->page, AllocSize);
+            delete node;
+            node = next;
+        }
+    }
+
+    void *get_chunk()
+    {
+        ThreadCache &cache{thread_cache()};
+        std::size_t chunk_count{cache.chunk_count.load(std::memory_order_relaxed)};
+        if (chunk_count == 0)
+        {
+            chunk_count = refill(cache);
+            if (chunk_count == 0)
+                return nullptr;
+        }
+
+        cache.chunk_count.store(--chunk_count, std::memory_order_relaxed);
+        return cache.chunks[chunk_count];
+    }
+
+    void return_chunk(void *chunk_ptr)
+    {
+        ThreadCache &cache{thread_cache()};
+        std::size_t chunk_count{cache.chunk_count.load(std::memory_order_relaxed)};
+        if (chunk_count == std::size(cache.chunks))
+        {
+            std::lock_guard lock{_depot_mutex};
+            drain_locked(cache, MAGAZINE_SIZE);
+            chunk_count -= MAGAZINE_SIZE;
+        }
+
+        cache.chunks[chunk_count] = chunk_ptr;
+        cache.chunk_count.store(chunk_count + 1, std::memory_order_relaxed);
+    }
+
+    // Gives the chunks cached by the calling thread back to the depot
+    void flush_thread_cache()
+    {
+        flush(thread_cache());
+    }
+
+    static constexpr std::size_t chunk_size()
+    {
+        return ChunkSize;
+    }
+
+    static constexpr std::size_t page_size()
+    {
+        return AllocSize;
+    }
+
+    std::size_t page_count() const
+    {
+        return _page_count.load(std::memory_order_relaxed);
+    }
+
+    // Chunks waiting in the depot or in the thread caches.
+    // The caches of other threads may change while they are counted, so the count is approximate under contention.
+    std::size_t free_chunk_count()
+    {
+        std::lock_guard lock{_depot_mutex};
+        std::size_t chunk_count{_depot_chunks.size()};
+        for (const ThreadCache *cache : _thread_caches)
+            chunk_count += cache->chunk_count.load(std::memory_order_relaxed);
+        return chunk_count;
+    }
+
+    // Chunks currently handed out to callers
+    std::size_t used_chunk_count()
+    {
+        std::size_t carved_chunk_count{page_count() * CHUNK_COUNT_PER_PAGE};
+        std::size_t free_chunks{free_chunk_count()};
+        return carved_chunk_count > free_chunks ? carved_chunk_count - free_chunks : 0;
+    }
 };
 } // namespace Age::Memory
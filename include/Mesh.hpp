@@ -12,11 +12,21 @@
 
 namespace Age::Gfx
 {
+// A negative radius marks a mesh without known bounds, such meshes are never culled
+struct MeshBounds
+{
+    Math::Vector3 center{};
+    float radius{-1.0f};
+    Math::Vector3 aabb_min{};
+    Math::Vector3 aabb_max{};
+};
+
 struct MeshBuffers
 {
     GLuint vertex_array_object{};
     GLuint vertex_buffer_object{};
     GLuint index_buffer_object{};
+    MeshBounds bounds{};
 };
 
 enum struct DrawCommandType : std::uint16_t
@@ -25,12 +35,16 @@ enum struct DrawCommandType : std::uint16_t
     DRAW_ELEMENTS,
 };
 
+// The offset is the first vertex of array draws and the byte offset of the first index of element draws.
+// Element draws add the base vertex to the indices, so meshes sharing buffers keep their own indices.
 struct DrawCommand
 {
     DrawCommandType type{};
     OGL::RenderingMode rendering_mode{};
     std::uint32_t element_count{};
     std::size_t offset{};
+    std::int32_t base_vertex{};
+    OGL::IndexType index_type{OGL::IndexType::UNSIGNED_SHORT};
 };
 
 using MeshId = std::uint16_t;
@@ -42,6 +56,7 @@ struct Mesh
     std::uint32_t draw_command_offset{};
     std::uint16_t draw_command_count{};
     std::uint16_t mesh_buffers_index{};
+    MeshBounds bounds{};
 };
 
 struct MeshRef
@@ -61,7 +76,26 @@ extern std::vector<DrawCommand> g_draw_commands;
 extern std::vector<Mesh> g_meshes;
 
 void init_mesh_system();
+// Indexed triangle meshes created while enabled are reordered for the vertex cache, overdraw and vertex fetch
+void set_mesh_optimization(bool is_enabled);
+
+// The sphere is centered on the AABB, which is cheap and tight enough for culling
+MeshBounds compute_mesh_bounds(const Math::Vector3 *vertex_positions, std::size_t vertex_count);
+
+// Vertex compression options, the float attributes are converted when the mesh is created.
+// Half floats keep 11 significant bits, so half float positions only suit meshes with small coordinates.
+inline constexpr unsigned int HALF_FLOAT_POSITIONS{0b1};
+// Normalized GL_UNSIGNED_BYTE components, for colors within [0, 1]
+inline constexpr unsigned int BYTE_COLORS{0b10};
+// Normalized GL_INT_2_10_10_10_REV components
+inline constexpr unsigned int PACKED_NORMALS{0b100};
+inline constexpr unsigned int HALF_FLOAT_TEXTURE_COORDS{0b1000};
+inline constexpr unsigned int COMPACT_VERTICES{
+    HALF_FLOAT_POSITIONS | BYTE_COLORS | PACKED_NORMALS | HALF_FLOAT_TEXTURE_COORDS
+};
 
+// The vertices are interleaved into buffers shared by the meshes with the same attributes and compression,
+// MeshBuffers receives the shared objects so these meshes are drawn without switching vertex arrays
 void create_arrays_mesh(
     const Math::Vector3 *vertex_positions,
     const Math::Vector3 *vertex_colors,
@@ -70,7 +104,8 @@ void create_arrays_mesh(
     std::size_t vertex_count,
     OGL::RenderingMode rendering_mode,
     MeshBuffers &mesh_buffers,
-    DrawCommand &draw_command
+    DrawCommand &draw_command,
+    unsigned int vertex_compression = 0
 );
 
 void create_elements_mesh(
@@ -83,7 +118,24 @@ void create_elements_mesh(
     std::size_t vertex_index_count,
     OGL::RenderingMode rendering_mode,
     MeshBuffers &mesh_buffers,
-    DrawCommand &draw_command
+    DrawCommand &draw_command,
+    unsigned int vertex_compression = 0
+);
+
+// The indices are narrowed to 16 bits when the mesh has at most 65536 vertices,
+// larger meshes keep 32 bit indices and are still drawn with a single call
+void create_elements_mesh(
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count,
+    const std::uint32_t *vertex_indices,
+    std::size_t vertex_index_count,
+    OGL::RenderingMode rendering_mode,
+    MeshBuffers &mesh_buffers,
+    DrawCommand &draw_command,
+    unsigned int vertex_compression = 0
 );
 
 MeshBuffers &create_mesh_buffers(std::uint16_t &index);
@@ -112,8 +164,10 @@ void create_mesh(
     mesh.draw_command_count = Count;
 
     mesh_creator(mesh_buffers, draw_commands, std::forward<TArgs>(mesh_creator_args)...);
+    mesh.bounds = mesh_buffers.bounds;
 }
 
 const MeshBuffers &get_mesh_buffers(MeshId mesh_id);
 MeshDrawCommands get_mesh_draw_commands(MeshId mesh_id);
+const MeshBounds &get_mesh_bounds(MeshId mesh_id);
 } // namespace Age::Gfx
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Vector.hpp"
+
+namespace Age::Gfx
+{
+// Reordering of triangle list indices for the GPU, without any OpenGL call,
+// so exported meshes can be optimized offline as well as when meshes are created
+
+inline constexpr std::uint32_t ACMR_CACHE_SIZE{16};
+inline constexpr float OVERDRAW_ACMR_THRESHOLD{1.05f};
+
+// Average cache miss ratio, the vertices transformed per triangle with a FIFO post-transform cache.
+// It goes from about 0.5 for a regular grid to 3 when no vertex is reused.
+float compute_acmr(
+    std::span<const std::uint32_t> vertex_indices, std::size_t vertex_count, std::uint32_t cache_size = ACMR_CACHE_SIZE
+);
+
+// Forsyth's linear speed optimization, the triangle using the best scored vertices of a simulated LRU cache comes next
+void optimize_vertex_cache(std::span<std::uint32_t> vertex_indices, std::size_t vertex_count);
+
+// The triangles are split into clusters whose ACMR stays within the threshold of the current order,
+// then the outward facing clusters are drawn first so they hide the others
+void optimize_overdraw(
+    std::span<std::uint32_t> vertex_indices,
+    const Math::Vector3 *vertex_positions,
+    std::size_t vertex_count,
+    float acmr_threshold = OVERDRAW_ACMR_THRESHOLD
+);
+
+// The vertices are renumbered in their first use order, unused vertices come last.
+// Returns the previous index of each vertex.
+std::vector<std::uint32_t> optimize_vertex_fetch(std::span<std::uint32_t> vertex_indices, std::size_t vertex_count);
+
+struct MeshOptimizationResult
+{
+    float acmr_before{};
+    float acmr_after{};
+    // The vertex attributes have to be reordered the same way
+    std::vector<std::uint32_t> vertex_order{};
+};
+
+// Runs the vertex cache, overdraw and vertex fetch optimizations
+MeshOptimizationResult optimize_mesh(
+    std::span<std::uint32_t> vertex_indices, const Math::Vector3 *vertex_positions, std::size_t vertex_count
+);
+
+template <typename TVertex>
+std::vector<TVertex> reorder_vertices(const TVertex *vertices, std::span<const std::uint32_t> vertex_order)
+{
+    std::vector<TVertex> reordered_vertices(vertex_order.size());
+    for (std::size_t index{}; index < vertex_order.size(); ++index)
+        reordered_vertices[index] = vertices[vertex_order[index]];
+    return reordered_vertices;
+}
+} // namespace Age::Gfx
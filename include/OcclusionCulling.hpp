@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Components.hpp"
+#include "Matrix.hpp"
+#include "Mesh.hpp"
+#include "Vector.hpp"
+
+namespace Age::Gfx
+{
+// Occluders are rasterized with the CPU copy of the triangles registered for their mesh
+struct Occluder
+{
+    static constexpr auto TYPE{Core::ComponentType::OCCLUDER};
+
+    bool is_active{true};
+};
+
+// Triangle list
+struct OccluderMesh
+{
+    std::vector<Math::Vector3> vertex_positions{};
+    std::vector<std::uint16_t> vertex_indices{};
+};
+
+void create_occluder_mesh(
+    MeshId mesh_id, std::span<const Math::Vector3> vertex_positions, std::span<const std::uint16_t> vertex_indices
+);
+// Returns null when no occluder mesh was registered for the mesh
+const OccluderMesh *get_occluder_mesh(MeshId mesh_id);
+
+inline constexpr std::size_t OCCLUSION_BUFFER_WIDTH{256};
+inline constexpr std::size_t OCCLUSION_BUFFER_HEIGHT{128};
+inline constexpr std::size_t OCCLUSION_TILE_SIZE{32};
+inline constexpr std::size_t OCCLUSION_LEVEL_COUNT{8};
+
+// Low resolution depth buffer filled on the CPU with the occluders seen by a camera,
+// the depths are normalized device depths remapped to [0, 1] and the buffer is cleared to 1.
+// Occluder triangles are binned per tile and the tiles are rasterized in parallel,
+// then a pyramid keeps the farthest depth of each 2x2 block so bounds are tested against a few texels.
+class OcclusionBuffer
+{
+    static constexpr std::size_t TILE_COLUMN_COUNT{OCCLUSION_BUFFER_WIDTH / OCCLUSION_TILE_SIZE};
+    static constexpr std::size_t TILE_ROW_COUNT{OCCLUSION_BUFFER_HEIGHT / OCCLUSION_TILE_SIZE};
+    static constexpr std::size_t TILE_COUNT{TILE_COLUMN_COUNT * TILE_ROW_COUNT};
+
+    // Edge functions and depth plane relative to the first vertex, in buffer pixels
+    struct Triangle
+    {
+        float origin_x{};
+        float origin_y{};
+        float edge_xs[3]{};
+        float edge_ys[3]{};
+        float edge_offsets[3]{};
+        float depth{};
+        float depth_dx{};
+        float depth_dy{};
+        std::uint16_t min_x{};
+        std::uint16_t min_y{};
+        std::uint16_t max_x{};
+        std::uint16_t max_y{};
+    };
+
+    Math::Matrix4 _world_to_clip_matrix{};
+    std::vector<Math::Vector4> _clip_positions{};
+    std::vector<Triangle> _triangles{};
+    std::array<std::vector<std::uint32_t>, TILE_COUNT> _tile_triangle_indexes{};
+    std::array<std::uint32_t, TILE_COUNT> _tile_indexes{};
+    std::array<std::vector<float>, OCCLUSION_LEVEL_COUNT> _depth_levels{};
+
+    void add_triangle(const Math::Vector4 (&clip_positions)[3]);
+    void rasterize_tile(std::uint32_t tile_index);
+    void build_depth_pyramid();
+
+  public:
+    OcclusionBuffer();
+
+    void begin(const Math::Matrix4 &world_to_clip_matrix);
+    void add_occluder(const Math::Matrix4 &local_to_world_matrix, const OccluderMesh &mesh);
+    void rasterize();
+
+    // Conservative, bounds crossing the near plane are never occluded
+    bool is_sphere_occluded(const Math::Vector3 &center, float radius) const;
+
+    float get_depth(std::size_t level, std::size_t x, std::size_t y) const;
+
+    std::size_t triangle_count() const
+    {
+        return _triangles.size();
+    }
+};
+} // namespace Age::Gfx
@@ -32,6 +32,33 @@ enum struct RenderingMode : std::uint16_t
     TRIANGLE_STRIP_ADJACENCY = GL_TRIANGLE_STRIP_ADJACENCY,
 };
 
+enum struct IndexType : std::uint16_t
+{
+    UNSIGNED_SHORT = GL_UNSIGNED_SHORT,
+    UNSIGNED_INT = GL_UNSIGNED_INT,
+};
+
+enum struct Capability : std::uint8_t
+{
+    CULL_FACE,
+    DEPTH_TEST,
+    DEPTH_CLAMP,
+    SCISSOR_TEST,
+    FRAMEBUFFER_SRGB,
+};
+
+// The functions changing bindings and fixed function state keep a shadow of the context state
+// and skip the calls that would not change it. The shadow starts from the state of a new context,
+// so the wrapped state must not be changed by direct OpenGL calls.
+struct StateCallCounters
+{
+    std::uint64_t issued_call_count{};
+    std::uint64_t filtered_call_count{};
+};
+
+StateCallCounters get_state_call_counters();
+void reset_state_call_counters();
+
 GLint get_integer(GLenum param_name);
 
 GLuint create_shader(ShaderType shader_type);
@@ -49,6 +76,7 @@ void set_uniform(GLint location, const Math::Matrix4 &matrix);
 GLuint get_uniform_block_index(GLuint shader_program, std::string_view name);
 void bind_uniform_block(GLuint shader_program, GLuint block_index, GLuint block_binding);
 
+void bind_array_buffer(GLuint array_buffer_object);
 void write_array_buffer(GLuint array_buffer_object, const void *data, std::size_t size);
 void write_array_buffer(GLuint array_buffer_object, std::size_t offset, const void *data, std::size_t size);
 
@@ -56,16 +84,56 @@ GLuint create_uniform_buffer();
 void allocate_uniform_buffer(GLuint uniform_buffer, std::size_t size);
 void write_uniform_buffer(GLuint uniform_buffer, const void *data, std::size_t size);
 void write_uniform_buffer(GLuint uniform_buffer, std::size_t offset, const void *data, std::size_t size);
+void *map_uniform_buffer(GLuint uniform_buffer, std::size_t offset, std::size_t size, GLbitfield access);
+void unmap_uniform_buffer(GLuint uniform_buffer);
 void bind_uniform_buffer_range(GLuint binding_point, GLuint uniform_buffer, std::size_t size);
 void bind_uniform_buffer_range(GLuint binding_point, GLuint uniform_buffer, std::size_t offset, std::size_t size);
 
 void bind_vertex_array_object(GLuint vao);
 
+// Also makes the texture unit active, for the calls editing the bound texture
+void bind_texture(GLuint texture_unit, GLenum target, GLuint texture);
+void bind_sampler(GLuint texture_unit, GLuint sampler);
+
+void set_capability(Capability capability, bool enable);
 void enable_srgb_rendering(bool enable);
 
+void set_viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void set_scissor_box(GLint x, GLint y, GLsizei width, GLsizei height);
+
 void set_clear_color(const Math::Vector4 &color);
 void set_clear_depth(float depth);
+void clear(GLbitfield buffers);
+
+std::size_t get_index_size(IndexType index_type);
 
 void draw_arrays(RenderingMode rendering_mode, std::uint32_t element_count, std::size_t start_index);
-void draw_elements(RenderingMode rendering_mode, std::uint32_t element_count, std::size_t buffer_offset);
+// The base vertex is added to the indices read from the bound index buffer
+void draw_elements(
+    RenderingMode rendering_mode,
+    std::uint32_t element_count,
+    IndexType index_type,
+    std::size_t buffer_offset,
+    std::int32_t base_vertex = 0
+);
+// The draws are given by arrays of element counts, index buffer offsets and base vertices
+void multi_draw_elements(
+    RenderingMode rendering_mode,
+    IndexType index_type,
+    const GLsizei *element_counts,
+    const void *const *buffer_offsets,
+    const GLint *base_vertices,
+    std::uint32_t draw_count
+);
+void draw_arrays_instanced(
+    RenderingMode rendering_mode, std::uint32_t element_count, std::size_t start_index, std::uint32_t instance_count
+);
+void draw_elements_instanced(
+    RenderingMode rendering_mode,
+    std::uint32_t element_count,
+    IndexType index_type,
+    std::size_t buffer_offset,
+    std::uint32_t instance_count,
+    std::int32_t base_vertex = 0
+);
 } // namespace Age::Gfx::OGL
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
+#include <type_traits>
 
+#include "Blob.hpp"
 #include "Components.hpp"
 #include "Transform.hpp"
 #include "Vector.hpp"
@@ -13,7 +14,7 @@ struct PathFollower
 {
     static constexpr auto TYPE{ComponentType::PATH_FOLLOWER};
 
-    std::vector<Math::Vector3> path{};
+    Blob<Math::Vector3> path{};
     std::uint32_t target_index{};
     Math::Vector3 target_position{};
     float target_min_distance{0.1f};
@@ -21,5 +22,7 @@ struct PathFollower
     bool repeat_path{};
 };
 
+static_assert(std::is_trivially_copyable_v<PathFollower>);
+
 void move_along_path(Transform &transform, PathFollower &path_follower);
 } // namespace Age::Core
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Definitions.hpp"
+
+namespace Age::Core
+{
+// Builds defining AGE_PROFILING record the zones opened by the AGE_PROFILE_* macros,
+// the macros expand to nothing otherwise.
+// CPU zones are written into a ring buffer owned by the calling thread, so worker threads can open zones too.
+// GPU zones measure the GL commands issued in their scope with GL_TIME_ELAPSED queries,
+// read back a few frames later to not stall the pipeline. GL_TIME_ELAPSED queries cannot nest, neither can GPU zones.
+
+// Times are relative to the profiling initialization
+struct ProfileZone
+{
+    std::string_view name{};
+    std::uint64_t start_ns{};
+    std::uint64_t end_ns{};
+    // Index of the thread in registration order, GPU zones use GPU_THREAD_INDEX
+    std::uint32_t thread_index{};
+    // Number of zones of the same thread enclosing this one
+    std::uint32_t depth{};
+};
+
+inline constexpr std::uint32_t GPU_THREAD_INDEX{0xFFFF};
+
+class CpuProfileScope
+{
+    std::string_view _name;
+    std::uint64_t _start_ns;
+
+  public:
+    explicit CpuProfileScope(std::string_view name);
+    ~CpuProfileScope();
+
+    CpuProfileScope(const CpuProfileScope &) = delete;
+    CpuProfileScope &operator=(const CpuProfileScope &) = delete;
+};
+
+class GpuProfileScope
+{
+    bool _is_query_started;
+
+  public:
+    explicit GpuProfileScope(std::string_view name);
+    ~GpuProfileScope();
+
+    GpuProfileScope(const GpuProfileScope &) = delete;
+    GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+};
+
+// Needs the OpenGL context
+void init_profiling(const App::Definitions &definitions);
+
+// The zones recorded since the last dump, the GPU ones once their queries are read back
+std::vector<ProfileZone> get_profile_zones();
+
+// Logs the total time spent in each zone
+void log_profile_zones(std::span<const ProfileZone> zones);
+// The trace event format read by chrome://tracing and Perfetto
+bool write_chrome_trace(std::span<const ProfileZone> zones, std::string_view file_path);
+
+// Must be called once at the end of every frame, when no worker thread is recording zones
+void update_profiling();
+} // namespace Age::Core
+
+#ifdef AGE_PROFILING
+#define AGE_PROFILE_CONCAT_IMPL(left, right) left##right
+#define AGE_PROFILE_CONCAT(left, right) AGE_PROFILE_CONCAT_IMPL(left, right)
+#define AGE_PROFILE_SCOPE(name) Age::Core::CpuProfileScope AGE_PROFILE_CONCAT(age_cpu_profile_scope_, __LINE__)(name)
+#define AGE_PROFILE_GPU_SCOPE(name)                                                                                    \
+    Age::Core::GpuProfileScope AGE_PROFILE_CONCAT(age_gpu_profile_scope_, __LINE__)(name)
+#else
+#define AGE_PROFILE_SCOPE(name)
+#define AGE_PROFILE_GPU_SCOPE(name)
+#endif
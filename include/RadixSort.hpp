@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace Age::Util
+{
+// Stable LSD radix sort of the values on the bits of their 64 bits key from first_bit upward.
+// The values equal on those bits keep their order, so values already ordered by the lower bits are fully sorted.
+// The keys are taken relative to their minimum, and their range is split into as few digits of at most
+// MAX_DIGIT_BIT_COUNT bits as possible, so a narrow range of keys takes a single pass.
+// buffer must hold as many values as values.
+template <typename T, typename TGetKey>
+void radix_sort(std::span<T> values, std::span<T> buffer, unsigned int first_bit, TGetKey get_key)
+{
+    // The buckets of a digit stay in the L1 cache while the values are scattered
+    constexpr unsigned int MAX_DIGIT_BIT_COUNT{10};
+    constexpr unsigned int MAX_DIGIT_COUNT{(64 + MAX_DIGIT_BIT_COUNT - 1) / MAX_DIGIT_BIT_COUNT};
+
+    if (values.empty())
+        return;
+
+    std::uint64_t min_key{~std::uint64_t{}};
+    std::uint64_t max_key{};
+    for (const T &value : values)
+    {
+        std::uint64_t key{get_key(value) >> first_bit};
+        min_key = std::min(min_key, key);
+        max_key = std::max(max_key, key);
+    }
+
+    unsigned int key_bit_count{static_cast<unsigned int>(std::bit_width(max_key - min_key))};
+    if (key_bit_count == 0)
+        return;
+
+    unsigned int digit_count{(key_bit_count + MAX_DIGIT_BIT_COUNT - 1) / MAX_DIGIT_BIT_COUNT};
+    unsigned int digit_bit_count{(key_bit_count + digit_count - 1) / digit_count};
+    std::uint64_t digit_mask{(std::uint64_t{1} << digit_bit_count) - 1};
+
+    std::array<std::array<std::uint32_t, 1U << MAX_DIGIT_BIT_COUNT>, MAX_DIGIT_COUNT> histograms{};
+    for (const T &value : values)
+    {
+        std::uint64_t key{(get_key(value) >> first_bit) - min_key};
+        for (unsigned int digit{}; digit < digit_count; ++digit)
+            ++histograms[digit][(key >> (digit * digit_bit_count)) & digit_mask];
+    }
+
+    T *source{values.data()};
+    T *destination{buffer.data()};
+    std::size_t value_count{values.size()};
+    for (unsigned int digit{}; digit < digit_count; ++digit)
+    {
+        unsigned int shift_count{digit * digit_bit_count};
+        std::array<std::uint32_t, 1U << MAX_DIGIT_BIT_COUNT> &histogram{histograms[digit]};
+        if (histogram[(((get_key(source[0]) >> first_bit) - min_key) >> shift_count) & digit_mask] == value_count)
+            continue;
+
+        std::uint32_t offset{};
+        for (std::size_t bucket{}; bucket <= digit_mask; ++bucket)
+        {
+            std::uint32_t count{histogram[bucket]};
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        for (std::size_t index{}; index < value_count; ++index)
+        {
+            std::uint64_t key{(get_key(source[index]) >> first_bit) - min_key};
+            destination[histogram[(key >> shift_count) & digit_mask]++] = source[index];
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != values.data())
+        std::copy(source, source + value_count, values.data());
+}
+} // namespace Age::Util
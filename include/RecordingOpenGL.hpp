@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Age::Gfx::OGL
+{
+// Builds defining AGE_RECORDING_OGL do not create any OpenGL context,
+// the OpenGL functions used by the engine are replaced by stubs appending their calls to an in-memory log.
+// The stubs return plausible values (object names, limits, successful compilations) so the engine runs unchanged.
+
+// Timestamps are relative to the loading of the recording functions
+struct RecordedCall
+{
+    std::string_view function_name{};
+    std::uint64_t timestamp_ns{};
+};
+
+// The preceding time is the time elapsed since the previous recorded call,
+// it measures the CPU work done by the engine before issuing each call
+struct RecordedFunctionStats
+{
+    std::string_view function_name{};
+    std::uint64_t call_count{};
+    std::uint64_t preceding_time_ns{};
+};
+
+// Returns false when one of the OpenGL functions used by the engine is left null
+bool load_recording_functions();
+
+void clear_recorded_calls();
+std::span<const RecordedCall> get_recorded_calls();
+
+std::uint64_t get_recorded_call_count(std::string_view function_name);
+// Only the functions called since the last clear
+std::vector<RecordedFunctionStats> get_recorded_function_stats();
+void log_recorded_function_stats();
+} // namespace Age::Gfx::OGL
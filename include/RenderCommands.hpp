@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Material.hpp"
+#include "Matrix.hpp"
+#include "Mesh.hpp"
+#include "OpenGL.hpp"
+#include "UniformBuffer.hpp"
+
+namespace Age::Gfx
+{
+enum struct RenderCommandType : std::uint8_t
+{
+    USE_MATERIAL,
+    BIND_UNIFORM_BUFFER_RANGE,
+    BIND_STREAMED_UNIFORM_BUFFER_RANGE,
+    SET_LW_MATRIX,
+    SET_LW_NORMAL_MATRIX,
+    BIND_VERTEX_ARRAY,
+    DRAW,
+    MULTI_DRAW,
+};
+
+// The common uniform blocks of the shader of the used material
+enum struct ShaderUniformBlockType : std::uint8_t
+{
+    PROJECTION,
+    INSTANCE,
+    DRAW,
+};
+
+struct UseMaterialCommand
+{
+    static constexpr auto TYPE{RenderCommandType::USE_MATERIAL};
+
+    MaterialId material_id{};
+};
+
+struct BindUniformBufferRangeCommand
+{
+    static constexpr auto TYPE{RenderCommandType::BIND_UNIFORM_BUFFER_RANGE};
+
+    ShaderUniformBlockType block_type{};
+    UniformBufferRangeId uniform_buffer_range_id{};
+};
+
+struct BindStreamedUniformBufferRangeCommand
+{
+    static constexpr auto TYPE{RenderCommandType::BIND_STREAMED_UNIFORM_BUFFER_RANGE};
+
+    ShaderUniformBlockType block_type{};
+    GLuint buffer_object{};
+    std::size_t offset{};
+    std::size_t size{};
+};
+
+struct SetLwMatrixCommand
+{
+    static constexpr auto TYPE{RenderCommandType::SET_LW_MATRIX};
+
+    Math::Matrix4 lw_matrix{};
+};
+
+struct SetLwNormalMatrixCommand
+{
+    static constexpr auto TYPE{RenderCommandType::SET_LW_NORMAL_MATRIX};
+
+    Math::Matrix3 lw_normal_matrix{};
+};
+
+struct BindVertexArrayCommand
+{
+    static constexpr auto TYPE{RenderCommandType::BIND_VERTEX_ARRAY};
+
+    GLuint vertex_array_object{};
+};
+
+// Draws are instanced when the instance count is not 0
+struct DrawRenderCommand
+{
+    static constexpr auto TYPE{RenderCommandType::DRAW};
+
+    DrawCommand draw_command{};
+    std::uint32_t instance_count{};
+};
+
+// Non instanced element draws recorded without any other command between them,
+// the draws are stored in the arrays of the command buffer
+struct MultiDrawRenderCommand
+{
+    static constexpr auto TYPE{RenderCommandType::MULTI_DRAW};
+
+    OGL::RenderingMode rendering_mode{};
+    OGL::IndexType index_type{};
+    std::uint32_t first_draw_index{};
+    std::uint32_t draw_count{};
+};
+
+// Packed commands, each one is its type followed by its bytes.
+// Recording does not touch the OpenGL context, so buffers can be recorded on any thread
+// while the execution has to happen on the thread owning the context.
+class RenderCommandBuffer
+{
+    static constexpr std::size_t NO_MULTI_DRAW{std::numeric_limits<std::size_t>::max()};
+
+    std::vector<std::byte> _bytes{};
+    // Offset of the multi draw ending the buffer, the element draws of the next mesh can extend it
+    std::size_t _last_multi_draw_offset{NO_MULTI_DRAW};
+    std::vector<GLsizei> _multi_draw_element_counts{};
+    std::vector<const void *> _multi_draw_offsets{};
+    std::vector<GLint> _multi_draw_base_vertices{};
+
+  public:
+    template <typename TCommand>
+    void record(const TCommand &command)
+    {
+        static_assert(std::is_trivially_copyable_v<TCommand>, "Render commands must be trivially copyable");
+
+        std::size_t offset{_bytes.size()};
+        _bytes.resize(offset + sizeof(RenderCommandType) + sizeof(TCommand));
+        std::memcpy(&_bytes[offset], &TCommand::TYPE, sizeof(RenderCommandType));
+        std::memcpy(&_bytes[offset + sizeof(RenderCommandType)], &command, sizeof(TCommand));
+        _last_multi_draw_offset = NO_MULTI_DRAW;
+    }
+
+    // Records the draws of a mesh, consecutive element draws without instancing and with the same rendering mode
+    // and index type become a single multi draw.
+    // The multi draw of the previous mesh is extended when no command was recorded since: the render items share
+    // their material and vertex array and have no per draw data, so meshes of the same vertex buffers are merged.
+    // Items with per draw data are never merged as GL 3.3 shaders have no draw id to select it.
+    void record_mesh_draws(std::span<const DrawCommand> draw_commands, std::uint32_t instance_count);
+
+    void clear()
+    {
+        _bytes.clear();
+        _last_multi_draw_offset = NO_MULTI_DRAW;
+        _multi_draw_element_counts.clear();
+        _multi_draw_offsets.clear();
+        _multi_draw_base_vertices.clear();
+    }
+
+    bool empty() const
+    {
+        return _bytes.empty();
+    }
+
+    std::size_t size() const
+    {
+        return _bytes.size();
+    }
+
+    void execute() const;
+};
+} // namespace Age::Gfx
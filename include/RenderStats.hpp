@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Definitions.hpp"
+#include "OpenGL.hpp"
+
+namespace Age::Gfx
+{
+// The binds and switches only count the calls reaching OpenGL, the ones filtered as redundant are left out.
+// Vertices and triangles are the submitted ones, multiplied by the instance counts.
+struct RenderStats
+{
+    std::uint64_t frame_index{};
+    std::uint32_t draw_call_count{};
+    std::uint32_t instanced_draw_call_count{};
+    std::uint32_t multi_draw_call_count{};
+    // Draws submitted through the multi draw calls
+    std::uint32_t multi_drawn_draw_count{};
+    std::uint64_t instance_count{};
+    std::uint64_t vertex_count{};
+    std::uint64_t triangle_count{};
+    std::uint32_t material_switch_count{};
+    std::uint32_t shader_switch_count{};
+    std::uint32_t vertex_array_bind_count{};
+    std::uint32_t texture_bind_count{};
+    std::uint32_t sampler_bind_count{};
+    std::uint32_t uniform_buffer_bind_count{};
+    // Bytes written to buffers or mapped for writing
+    std::uint64_t uploaded_byte_count{};
+    OGL::StateCallCounters state_call_counters{};
+};
+
+// Counters of the frame being rendered
+extern RenderStats g_render_stats;
+
+void init_render_stats(const App::Definitions &definitions);
+
+const RenderStats &get_last_frame_render_stats();
+// The stats of the last rendered frames, oldest first
+std::vector<RenderStats> get_render_stats_history();
+
+// Logs the average and maximum of each counter over the given frames
+void log_render_stats(std::span<const RenderStats> stats);
+
+// Must be called once at the end of every rendered frame
+void update_render_stats();
+} // namespace Age::Gfx
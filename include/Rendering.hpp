@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <limits>
 
+#include "BVH.hpp"
+#include "Culling.hpp"
 #include "GLFW.hpp"
 #include "Material.hpp"
 #include "Matrix.hpp"
@@ -12,51 +14,74 @@
 
 namespace Age::Gfx
 {
-struct LocalToViewMatrix
-{
-    static constexpr auto TYPE{Core::ComponentType::LOCAL_TO_VIEW_MATRIX};
-
-    Math::Matrix4 matrix{};
-};
-
-struct LocalToViewNormalMatrix
-{
-    static constexpr auto TYPE{Core::ComponentType::LOCAL_TO_VIEW_NORMAL_MATRIX};
-
-    Math::Matrix3 matrix{};
-};
-
+// Holds no pointer into the chunks, the per frame data of the renderers is copied out by an extraction phase
 struct DrawCall
 {
-    const Math::Matrix4 *lv_matrix{};
-    const Math::Matrix3 *lv_normal_matrix{};
+    Core::EntityId entity_id{};
+    BvhItemId bvh_item_id{INVALID_BVH_ITEM_ID};
     MaterialId material_id{};
     MeshId mesh_id{};
+    // WITH_* options of the renderer
+    std::uint8_t options{};
+    // Renderers without a Transform keep the identity matrices and are never culled
+    bool has_transform{};
 };
 
 using DrawCallIndex = std::uint32_t;
-using DrawCallSortKey = std::uint32_t;
+// From the most to the least significant bits:
+// opaque draw calls: pass (4) | 0 (1) | material (24) | mesh (16) | unused (19), drawn in state order
+// translucent draw calls: pass (4) | 1 (1) | inverted depth (19) | material (24) | mesh (16), drawn back to front
+using DrawCallSortKey = std::uint64_t;
+
+inline constexpr DrawCallIndex INVALID_DRAW_CALL_INDEX{std::numeric_limits<DrawCallIndex>::max()};
 
 struct DrawCallKey
 {
-    DrawCallIndex index{std::numeric_limits<DrawCallIndex>::max()};
+    DrawCallIndex index{INVALID_DRAW_CALL_INDEX};
     DrawCallSortKey sort_key{std::numeric_limits<DrawCallSortKey>::max()};
 };
 
+// Initialized renderers are kept in a sorted draw list,
+// their activity, material and mesh are changed through the set_renderer_* functions so the list follows
 struct Renderer
 {
     static constexpr auto TYPE{Core::ComponentType::RENDERER};
 
     DrawCallKey draw_call_key{};
     bool is_active{true};
+    // Passes are drawn in increasing order, translucent draw calls after opaque ones in each pass
+    std::uint8_t render_pass{};
+    bool is_translucent{};
+
+    // Called by Core::destroy_entity(), releases the draw call
+    static void on_destroy(Core::EntityId entity_id, Renderer &renderer);
 };
 
 void init_rendering_system(GLFWwindow *window);
+// Renders into the framebuffer bound by the headless context instead of a window
+void init_headless_rendering_system(unsigned int framebuffer_width, unsigned int framebuffer_height);
 
-inline constexpr unsigned int WITH_LV_MATRIX{0b1};
-inline constexpr unsigned int WITH_LV_NORMAL_MATRIX{0b10};
+// The local to world matrices are computed once per frame from the Transform of the renderer entity,
+// the shaders apply the world to view matrix of the ProjectionBlock
+inline constexpr unsigned int WITH_LW_MATRIX{0b1};
+inline constexpr unsigned int WITH_LW_NORMAL_MATRIX{0b10};
+// Renderers without world bounds are drawn by all the cameras
+inline constexpr unsigned int WITH_WORLD_BOUNDS{0b100};
+// The bounds and matrices of static renderers are only computed again after mark_renderer_moved()
+// or set_renderer_mesh(), the other renderers are updated every frame
+inline constexpr unsigned int WITH_STATIC_TRANSFORM{0b1000};
 
 void init_renderer(Core::EntityId entity_id, unsigned int options = 0);
+void set_renderer_active(Core::EntityId entity_id, bool is_active);
+void set_renderer_material(Core::EntityId entity_id, MaterialId material_id);
+void set_renderer_mesh(Core::EntityId entity_id, MeshId mesh_id);
+// To call after changing the Transform of a static renderer
+void mark_renderer_moved(Core::EntityId entity_id);
+// Releases the draw call of the renderer, init_renderer can be called again afterwards
+void remove_renderer(Core::EntityId entity_id);
+
+// The values of the scene BVH items are draw call indexes
+const BoundingVolumeHierarchy &get_scene_bvh();
 
 void render();
 void update_render_state();
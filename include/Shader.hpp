@@ -4,6 +4,7 @@
 #include <memory>
 #include <span>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "OpenGL.hpp"
@@ -27,8 +28,12 @@ struct ShaderRenderState
 struct ShaderCommonUniforms
 {
     bool projection_block : 1 {true};
-    bool lv_matrix : 1 {true};
-    bool lv_normal_matrix : 1 {false};
+    bool lw_matrix : 1 {true};
+    bool lw_normal_matrix : 1 {false};
+    // Instanced shaders read their matrices from the InstanceBlock array indexed by gl_InstanceID
+    bool instancing : 1 {false};
+    // Shaders with a DrawBlock read their matrices from a range of the per-frame draw data buffer
+    bool draw_block : 1 {false};
 };
 
 struct Shader
@@ -36,8 +41,10 @@ struct Shader
     ShaderRenderState render_state{};
     GLuint shader_program{};
     UniformBlock projection_block{};
-    GLint lv_matrix{-1};
-    GLint lv_normal_matrix{-1};
+    GLint lw_matrix{-1};
+    GLint lw_normal_matrix{-1};
+    UniformBlock instance_block{};
+    UniformBlock draw_block{};
 
     Shader(GLuint shader_program, ShaderCommonUniforms common_uniforms = {}, ShaderRenderState render_state = {});
 };
@@ -48,14 +55,14 @@ void init_shader_system();
 
 GLuint create_shader_program(std::span<const ShaderAsset> shader_assets);
 
-template <typename TShader>
-void create_shader(ShaderId shader_id, std::span<const ShaderAsset> shader_assets)
+template <typename TShader, typename... TArgs>
+void create_shader(ShaderId shader_id, std::span<const ShaderAsset> shader_assets, TArgs &&...args)
 {
     if (shader_id >= g_shaders.size())
         g_shaders.resize(shader_id + 1);
 
     GLuint shader_program{create_shader_program(shader_assets)};
-    g_shaders[shader_id] = std::make_unique<TShader>(shader_program);
+    g_shaders[shader_id] = std::make_unique<TShader>(shader_program, std::forward<TArgs>(args)...);
 }
 
 Shader &get_shader(ShaderId shader_id);
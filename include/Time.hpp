@@ -6,6 +6,7 @@ float frame_time();
 float delta_time();
 float current_time();
 
-void init_frame_time();
+// Each frame advances the frame time by the fixed delta time when it is not 0, for reproducible runs
+void init_frame_time(float fixed_delta_time = 0.0f);
 void update_frame_time();
 } // namespace Age::Time
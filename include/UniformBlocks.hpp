@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "Matrix.hpp"
 #include "Vector.hpp"
 
@@ -12,6 +14,17 @@ struct FragmentPositionDataBlock
     int height{};
 };
 
+// Content of the DrawBlock and element of the InstanceBlock array of instanced shaders,
+// the normal matrix columns are padded as in std140
+struct InstanceData
+{
+    Math::Matrix4 lw_matrix{};
+    Math::Vector4 lw_normal_matrix[3]{};
+};
+
+// Must match the InstanceBlock array size of the instanced shaders
+inline constexpr std::size_t MAX_INSTANCE_COUNT{128};
+
 struct MaterialBlock
 {
     Math::Vector4 specular_color{};
@@ -11,6 +11,7 @@
 namespace Age::Gfx
 {
 std::size_t get_uniform_block_aligned_size(std::size_t block_size);
+std::size_t get_uniform_buffer_offset_alignment();
 
 enum struct UniformBufferBinding : GLuint
 {
@@ -184,6 +185,21 @@ struct UniformBufferWriter<UniformBuffer<TParam>>
     }
 };
 
+// Ring buffer for data rewritten every frame: writes are appended through unsynchronized mappings
+// and the buffer is orphaned when full, so writing never waits for the GPU to finish reading older data
+struct StreamingUniformBuffer
+{
+    GLuint buffer_object{};
+    std::size_t size{};
+    std::size_t offset{};
+
+    StreamingUniformBuffer() = default;
+    StreamingUniformBuffer(GLuint buffer_object, std::size_t size);
+
+    // Returns the offset of the written data, aligned for uniform buffer range bindings
+    std::size_t write(const void *data, std::size_t data_size);
+};
+
 template <typename TBlock, typename... TParams>
 UniformBuffer<TBlock> create_uniform_buffer(TParams &&...params)
 {
@@ -196,4 +212,9 @@ void init_uniform_buffer_system();
 void bind_uniform_buffer_range(
     GLuint shader_program, UniformBlock &uniform_block, UniformBufferRangeId uniform_buffer_range_id
 );
+
+// Streamed ranges change every draw so they skip the range ids and use a binding reserved for them
+void bind_streamed_uniform_buffer_range(
+    GLuint shader_program, UniformBlock &uniform_block, GLuint buffer_object, std::size_t offset, std::size_t size
+);
 } // namespace Age::Gfx
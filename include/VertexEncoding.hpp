@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Vector.hpp"
+
+namespace Age::Gfx
+{
+// Conversions of float vertex attributes to the compact encodings read by OpenGL
+
+// IEEE 754 binary16 rounded to nearest with ties away from zero, out of range values become infinities
+std::uint16_t encode_half_float(float value);
+
+// GL_INT_2_10_10_10_REV with normalization, the components are clamped to [-1, 1] and w is 0
+std::uint32_t encode_packed_normal(const Math::Vector3 &normal);
+
+// Normalized GL_UNSIGNED_BYTE components in x, y, z order, the components are clamped to [0, 1] and w is 255
+std::uint32_t encode_byte_color(const Math::Vector3 &color);
+} // namespace Age::Gfx
@@ -23,6 +23,8 @@ bool has_framebuffer_size_changed();
 void get_framebuffer_size(unsigned int &width, unsigned int &height);
 
 void init_viewport_system(GLFWwindow *window);
+// Fixed size framebuffer, used by headless runs
+void init_viewport_system(unsigned int framebuffer_width, unsigned int framebuffer_height);
 
 void start_viewports_update();
 void end_viewports_update();
@@ -26,6 +26,8 @@ enum ComponentType : std::underlying_type_t<Age::Core::ComponentType>
     VIEW_MATRIX_READER,
     POST_PROJECTION_ROTATION,
     ROTATION_OVER_TIME,
+    FIREFLY,
+    STONE_HIGHLIGHT,
 
     LAST_VALUE
 };
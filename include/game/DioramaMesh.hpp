@@ -5,4 +5,5 @@
 namespace Game
 {
 void create_diorama_mesh(Age::Gfx::MeshBuffers &mesh_buffers, std::span<Age::Gfx::DrawCommand, 1> draw_commands);
+void create_diorama_occluder_mesh(Age::Gfx::MeshId mesh_id);
 }
@@ -17,4 +17,21 @@ struct SphereImpostor
 void create_sphere_impostors_mesh(
     Age::Gfx::MeshBuffers &mesh_buffer, std::span<Age::Gfx::DrawCommand, 1> draw_commands, std::size_t impostor_count
 );
+
+// Pyramid with its vertices in world space, standing on position
+void create_waymark_mesh(
+    Age::Gfx::MeshBuffers &mesh_buffer,
+    std::span<Age::Gfx::DrawCommand, 1> draw_commands,
+    Age::Math::Vector3 position,
+    Age::Math::Vector3 color
+);
+
+// Patch of soil covered by grass blades, with its vertices in world space and centered on position.
+// The blades have too many vertices for 16 bit indices and are drawn by the second draw command
+void create_meadow_mesh(
+    Age::Gfx::MeshBuffers &mesh_buffer,
+    std::span<Age::Gfx::DrawCommand, 2> draw_commands,
+    Age::Math::Vector3 position,
+    float radius
+);
 } // namespace Game
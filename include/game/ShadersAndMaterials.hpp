@@ -16,7 +16,10 @@ struct FragmentLightingShader : public Age::Gfx::Shader
     Age::Gfx::UniformBlock material_block{};
     GLint gaussian_texture{-1};
 
-    FragmentLightingShader(GLuint shader_program);
+    FragmentLightingShader(
+        GLuint shader_program,
+        Age::Gfx::ShaderCommonUniforms common_uniforms = {.lw_matrix = false, .draw_block = true}
+    );
 };
 
 struct FragmentLightingMaterial : public Age::Gfx::Material
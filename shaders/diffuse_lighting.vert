@@ -3,12 +3,13 @@
 layout(location = 0) in vec4 aPosition;
 layout(location = 1) in vec3 aNormal;
 
-uniform mat4 _localToViewMatrix;
-uniform mat3 uNormalLocalToViewMatrix;
+uniform mat4 _localToWorldMatrix;
+uniform mat3 _localToWorldNormalMatrix;
 
 layout(std140) uniform ProjectionBlock
 {
     mat4 uViewToClipMatrix;
+    mat4 _worldToViewMatrix;
 };
 
 uniform vec3 uLightPosition;
@@ -21,9 +22,9 @@ void main()
 {
     vec4 diffuseColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
-    vec4 viewPosition = _localToViewMatrix * aPosition;
+    vec4 viewPosition = _worldToViewMatrix * (_localToWorldMatrix * aPosition);
     gl_Position = uViewToClipMatrix * viewPosition;
-    vec3 normal = normalize(uNormalLocalToViewMatrix * aNormal);
+    vec3 normal = normalize(mat3(_worldToViewMatrix) * (_localToWorldNormalMatrix * aNormal));
 
     vec3 lightDirection = normalize(uLightPosition - vec3(viewPosition));
     float incidenceAngleCos = dot(normal, lightDirection);
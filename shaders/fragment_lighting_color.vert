@@ -5,13 +5,17 @@ layout(std140) uniform;
 layout(location = 0) in vec4 inPosition;
 layout(location = 2) in vec3 inNormal;
 
-uniform mat4 _localToViewMatrix;
-uniform mat3 _localToViewNormalMatrix;
+uniform DrawBlock
+{
+    mat4 _localToWorldMatrix;
+    mat3 _localToWorldNormalMatrix;
+};
 uniform vec4 _diffuseColor;
 
 uniform ProjectionBlock
 {
     mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
 };
 
 out Varyings
@@ -23,10 +27,10 @@ out Varyings
 
 void main()
 {
-    vec4 viewPosition = _localToViewMatrix * inPosition;
+    vec4 viewPosition = _worldToViewMatrix * (_localToWorldMatrix * inPosition);
     gl_Position = _viewToClipMatrix * viewPosition;
 
     Out.viewPosition = viewPosition;
     Out.diffuseColor = _diffuseColor;
-    Out.viewNormal = _localToViewNormalMatrix * inNormal;
+    Out.viewNormal = mat3(_worldToViewMatrix) * (_localToWorldNormalMatrix * inNormal);
 }
@@ -0,0 +1,41 @@
+#version 330
+
+layout(std140) uniform;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec3 inNormal;
+
+uniform ProjectionBlock
+{
+    mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
+};
+
+struct InstanceData
+{
+    mat4 localToWorldMatrix;
+    mat3 localToWorldNormalMatrix;
+};
+
+uniform InstanceBlock
+{
+    InstanceData _instances[128];
+};
+
+out Varyings
+{
+	vec4 viewPosition;
+	vec4 diffuseColor;
+	vec3 viewNormal;
+} Out;
+
+void main()
+{
+    vec4 viewPosition = _worldToViewMatrix * (_instances[gl_InstanceID].localToWorldMatrix * inPosition);
+    gl_Position = _viewToClipMatrix * viewPosition;
+
+    Out.viewPosition = viewPosition;
+    Out.diffuseColor = inColor;
+    Out.viewNormal = mat3(_worldToViewMatrix) * (_instances[gl_InstanceID].localToWorldNormalMatrix * inNormal);
+}
@@ -6,12 +6,13 @@ layout(location = 0) in vec4 inPosition;
 layout(location = 2) in vec3 inNormal;
 layout(location = 3) in vec2 inTexCoord;
 
-uniform mat4 _localToViewMatrix;
-uniform mat3 _localToViewNormalMatrix;
+uniform mat4 _localToWorldMatrix;
+uniform mat3 _localToWorldNormalMatrix;
 
 uniform ProjectionBlock
 {
     mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
 };
 
 uniform CubePointLightBlock
@@ -30,11 +31,11 @@ out Varyings
 
 void main()
 {
-    vec4 viewPosition = _localToViewMatrix * inPosition;
+    vec4 viewPosition = _worldToViewMatrix * (_localToWorldMatrix * inPosition);
     gl_Position = _viewToClipMatrix * viewPosition;
 
     Out.viewPosition = vec3(viewPosition);
-    Out.viewNormal = _localToViewNormalMatrix * inNormal;
+    Out.viewNormal = mat3(_worldToViewMatrix) * (_localToWorldNormalMatrix * inNormal);
     Out.texCoord = inTexCoord;
     Out.cubePointLightPosition = CubePointLight.viewToLightMatrix * viewPosition;
 }
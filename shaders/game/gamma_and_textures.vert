@@ -5,11 +5,12 @@ layout(std140) uniform;
 layout(location = 0) in vec4 inPosition;
 layout(location = 3) in vec2 inTexCoord;
 
-uniform mat4 _localToViewMatrix;
+uniform mat4 _localToWorldMatrix;
 
 uniform ProjectionBlock
 {
 	mat4 _viewToClipMatrix;
+	mat4 _worldToViewMatrix;
 };
 
 out Varyings
@@ -19,6 +20,6 @@ out Varyings
 
 void main()
 {
-	gl_Position = _viewToClipMatrix * (_localToViewMatrix * inPosition);
+	gl_Position = _viewToClipMatrix * (_worldToViewMatrix * (_localToWorldMatrix * inPosition));
 	Out.texCoord = inTexCoord;
 }
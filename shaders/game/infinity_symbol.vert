@@ -6,12 +6,13 @@ layout(location = 0) in vec4 inPosition;
 layout(location = 2) in vec3 inNormal;
 layout(location = 3) in vec2 inTextureCoord;
 
-uniform mat4 _localToViewMatrix;
-uniform mat3 _localToViewNormalMatrix;
+uniform mat4 _localToWorldMatrix;
+uniform mat3 _localToWorldNormalMatrix;
 
 uniform ProjectionBlock
 {
     mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
 };
 
 out Varyings
@@ -23,10 +24,10 @@ out Varyings
 
 void main()
 {
-    vec4 viewPosition = _localToViewMatrix * inPosition;
+    vec4 viewPosition = _worldToViewMatrix * (_localToWorldMatrix * inPosition);
     gl_Position = _viewToClipMatrix * viewPosition;
 
     Out.viewPosition = viewPosition;
-    Out.viewNormal = _localToViewNormalMatrix * inNormal;
+    Out.viewNormal = mat3(_worldToViewMatrix) * (_localToWorldNormalMatrix * inNormal);
     Out.textureCoord = inTextureCoord;
 }
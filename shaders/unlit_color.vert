@@ -4,18 +4,23 @@ layout(std140) uniform;
 
 layout(location = 0) in vec4 inPosition;
 
-uniform mat4 _localToViewMatrix;
+uniform DrawBlock
+{
+    mat4 _localToWorldMatrix;
+    mat3 _localToWorldNormalMatrix;
+};
 uniform vec3 _color;
 
 uniform ProjectionBlock
 {
     mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
 };
 
 smooth out vec3 varColor;
 
 void main()
 {
-    gl_Position = _viewToClipMatrix * (_localToViewMatrix * inPosition);
+    gl_Position = _viewToClipMatrix * (_worldToViewMatrix * (_localToWorldMatrix * inPosition));
     varColor = _color;
 }
@@ -0,0 +1,32 @@
+#version 330
+
+layout(std140) uniform;
+
+layout(location = 0) in vec4 inPosition;
+
+uniform vec3 _color;
+
+uniform ProjectionBlock
+{
+    mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
+};
+
+struct InstanceData
+{
+    mat4 localToWorldMatrix;
+    mat3 localToWorldNormalMatrix;
+};
+
+uniform InstanceBlock
+{
+    InstanceData _instances[128];
+};
+
+smooth out vec3 varColor;
+
+void main()
+{
+    gl_Position = _viewToClipMatrix * (_worldToViewMatrix * (_instances[gl_InstanceID].localToWorldMatrix * inPosition));
+    varColor = _color;
+}
@@ -0,0 +1,21 @@
+#version 330
+
+layout(std140) uniform;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inDiffuseColor;
+
+uniform ProjectionBlock
+{
+    mat4 _viewToClipMatrix;
+    mat4 _worldToViewMatrix;
+};
+
+smooth out vec3 varColor;
+
+// The vertices are already in world space, so the draws need no per draw data
+void main()
+{
+    gl_Position = _viewToClipMatrix * (_worldToViewMatrix * inPosition);
+    varColor = inDiffuseColor;
+}
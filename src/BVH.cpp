@@ -0,0 +1,670 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "BVH.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+constexpr std::uint32_t MAX_LEAF_ITEM_COUNT{4};
+constexpr std::uint32_t MAX_DEPTH{64};
+constexpr std::uint32_t BIN_COUNT{16};
+// Cost of visiting a node relative to testing an item
+constexpr float TRAVERSAL_COST{2.0f};
+// Inserted and removed items trigger a rebuild past this count or a 32th of the tree items
+constexpr std::size_t MIN_CHANGED_ITEM_COUNT_FOR_REBUILD{64};
+// Items binned per update by the builds, a node is never split across updates.
+// A build of 100k items takes about 50 updates of 1.5 ms instead of a single one of 90 ms,
+// the first update with the root node and the last one swapping the trees take about 4 ms
+constexpr std::size_t MAX_BUILD_ITEM_COUNT_PER_UPDATE{32768};
+// Centroids closer than this along the split axis are treated as identical,
+// their bins would be scaled by an infinite or huge factor
+constexpr float MIN_CENTROID_EXTENT{1e-6f};
+constexpr std::uint8_t ALL_PLANES_MASK{0b111111};
+
+Math::Vector3 min(const Math::Vector3 &lhs, const Math::Vector3 &rhs)
+{
+    return {std::min(lhs.x, rhs.x), std::min(lhs.y, rhs.y), std::min(lhs.z, rhs.z)};
+}
+
+Math::Vector3 max(const Math::Vector3 &lhs, const Math::Vector3 &rhs)
+{
+    return {std::max(lhs.x, rhs.x), std::max(lhs.y, rhs.y), std::max(lhs.z, rhs.z)};
+}
+
+void expand(Aabb &aabb, const Aabb &other)
+{
+    aabb.min = min(aabb.min, other.min);
+    aabb.max = max(aabb.max, other.max);
+}
+
+// The vector operators are not inlined, the hot paths work on the components directly
+float get_axis_component(const Math::Vector3 &vector, std::size_t axis)
+{
+    return axis == 0 ? vector.x : axis == 1 ? vector.y : vector.z;
+}
+
+Aabb get_sphere_aabb(const Math::Vector3 &center, float radius)
+{
+    return {
+        {center.x - radius, center.y - radius, center.z - radius},
+        {center.x + radius, center.y + radius, center.z + radius}
+    };
+}
+
+float get_half_surface_area(const Aabb &aabb)
+{
+    float size_x{aabb.max.x - aabb.min.x};
+    float size_y{aabb.max.y - aabb.min.y};
+    float size_z{aabb.max.z - aabb.min.z};
+    if (size_x < 0.0f)
+        return 0.0f;
+    return size_x * size_y + size_y * size_z + size_z * size_x;
+}
+
+// Returns false when the box is outside the frustum,
+// otherwise clears the bits of the planes the box is entirely in front of.
+// Empty boxes, of nodes with only removed items, are infinite and would give NaN distances
+bool intersect_frustum(const Frustum &frustum, const Aabb &aabb, std::uint8_t &plane_mask)
+{
+    if (!(aabb.min.x <= aabb.max.x && aabb.min.y <= aabb.max.y && aabb.min.z <= aabb.max.z))
+        return false;
+
+    for (std::size_t plane_index{}; plane_index < 6; ++plane_index)
+    {
+        if (!(plane_mask & (1U << plane_index)))
+            continue;
+
+        const Math::Vector4 &plane{frustum.planes[plane_index]};
+        float farthest_distance{
+            plane.x * (plane.x >= 0.0f ? aabb.max.x : aabb.min.x) +
+            plane.y * (plane.y >= 0.0f ? aabb.max.y : aabb.min.y) +
+            plane.z * (plane.z >= 0.0f ? aabb.max.z : aabb.min.z) + plane.w
+        };
+        if (!(farthest_distance >= 0.0f))
+            return false;
+
+        float nearest_distance{
+            plane.x * (plane.x >= 0.0f ? aabb.min.x : aabb.max.x) +
+            plane.y * (plane.y >= 0.0f ? aabb.min.y : aabb.max.y) +
+            plane.z * (plane.z >= 0.0f ? aabb.min.z : aabb.max.z) + plane.w
+        };
+        if (nearest_distance >= 0.0f)
+            plane_mask &= ~(1U << plane_index);
+    }
+    return true;
+}
+
+float get_squared_distance(const Math::Vector3 &lhs, const Math::Vector3 &rhs)
+{
+    float offset_x{lhs.x - rhs.x};
+    float offset_y{lhs.y - rhs.y};
+    float offset_z{lhs.z - rhs.z};
+    return offset_x * offset_x + offset_y * offset_y + offset_z * offset_z;
+}
+
+bool intersect_sphere(const Aabb &aabb, const Math::Vector3 &center, float radius)
+{
+    return get_squared_distance(center, max(aabb.min, min(center, aabb.max))) <= radius * radius;
+}
+
+struct Ray
+{
+    Math::Vector3 origin{};
+    Math::Vector3 direction{};
+    Math::Vector3 inverse_direction{};
+    float max_distance{};
+};
+
+bool intersect_ray(const Aabb &aabb, const Ray &ray)
+{
+    float min_distance{0.0f};
+    float max_distance{ray.max_distance};
+    for (std::size_t axis{}; axis < 3; ++axis)
+    {
+        float origin{get_axis_component(ray.origin, axis)};
+        float inverse_direction{get_axis_component(ray.inverse_direction, axis)};
+        float distance_1{(get_axis_component(aabb.min, axis) - origin) * inverse_direction};
+        float distance_2{(get_axis_component(aabb.max, axis) - origin) * inverse_direction};
+        min_distance = std::max(min_distance, std::min(distance_1, distance_2));
+        max_distance = std::min(max_distance, std::max(distance_1, distance_2));
+    }
+    return min_distance <= max_distance;
+}
+
+bool intersect_ray(const Math::Vector3 &center, float radius, const Ray &ray)
+{
+    Math::Vector3 offset{center - ray.origin};
+    float center_distance{Math::dot(offset, ray.direction)};
+    float squared_ray_distance{Math::dot(offset, offset) - center_distance * center_distance};
+    if (squared_ray_distance > radius * radius)
+        return false;
+
+    float half_chord{std::sqrt(radius * radius - squared_ray_distance)};
+    return center_distance + half_chord >= 0.0f && center_distance - half_chord <= ray.max_distance;
+}
+} // namespace
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(float max_tree_cost_growth)
+    : _max_tree_cost_growth{max_tree_cost_growth}
+{
+}
+
+BvhItemId BoundingVolumeHierarchy::insert_item(const Math::Vector3 &center, float radius, std::uint32_t value)
+{
+    BvhItemId id;
+    if (_free_item_ids.empty())
+    {
+        id = static_cast<BvhItemId>(_items.size());
+        _items.emplace_back();
+    }
+    else
+    {
+        id = _free_item_ids.back();
+        _free_item_ids.pop_back();
+    }
+
+    _items[id] = {
+        .center = center, .radius = radius, .value = value, .generation = _items[id].generation + 1, .is_alive = true
+    };
+    _pending_item_ids.push_back(id);
+    return id;
+}
+
+void BoundingVolumeHierarchy::move_item(BvhItemId id, const Math::Vector3 &center, float radius)
+{
+    Item &item{_items[id]};
+    if (item.center.x == center.x && item.center.y == center.y && item.center.z == center.z && item.radius == radius)
+        return;
+
+    item.center = center;
+    item.radius = radius;
+    if (item.tree_item_index == NO_INDEX)
+        return;
+
+    _tree_item_spheres.set(item.tree_item_index, center, radius);
+
+    // Leaves are only refitted once an item leaves their bounds, they shrink back on the next build
+    const Aabb &leaf_bounds{_nodes[item.leaf_index].bounds};
+    Aabb item_bounds{get_sphere_aabb(center, radius)};
+    bool is_inside_leaf{
+        item_bounds.min.x >= leaf_bounds.min.x && item_bounds.min.y >= leaf_bounds.min.y &&
+        item_bounds.min.z >= leaf_bounds.min.z && item_bounds.max.x <= leaf_bounds.max.x &&
+        item_bounds.max.y <= leaf_bounds.max.y && item_bounds.max.z <= leaf_bounds.max.z
+    };
+    if (!is_inside_leaf)
+        mark_dirty(item.leaf_index);
+}
+
+void BoundingVolumeHierarchy::remove_item(BvhItemId id)
+{
+    Item &item{_items[id]};
+    item.is_alive = false;
+
+    if (item.tree_item_index == NO_INDEX)
+    {
+        auto pending_it = std::find(_pending_item_ids.begin(), _pending_item_ids.end(), id);
+        *pending_it = _pending_item_ids.back();
+        _pending_item_ids.pop_back();
+        _free_item_ids.push_back(id);
+        return;
+    }
+
+    // Removed items stay in their leaf until the next build
+    _tree_item_spheres.set(item.tree_item_index, item.center, -std::numeric_limits<float>::infinity());
+    _removed_item_ids.push_back(id);
+    mark_dirty(item.leaf_index);
+}
+
+void BoundingVolumeHierarchy::update()
+{
+    refit();
+    if (!_is_building)
+    {
+        std::size_t changed_item_count{_pending_item_ids.size() + _removed_item_ids.size()};
+        bool is_build_due{
+            changed_item_count > std::max(MIN_CHANGED_ITEM_COUNT_FOR_REBUILD, _tree_item_values.size() / 32) ||
+            _tree_cost > _built_tree_cost * _max_tree_cost_growth
+        };
+        if (!is_build_due)
+            return;
+        start_build();
+    }
+
+    // Without a previous tree all the items would be tested linearly until the build is done
+    std::size_t max_item_count{
+        _nodes.empty() ? std::numeric_limits<std::size_t>::max() : MAX_BUILD_ITEM_COUNT_PER_UPDATE
+    };
+    if (continue_build(max_item_count))
+        finish_build();
+}
+
+void BoundingVolumeHierarchy::rebuild()
+{
+    start_build();
+    continue_build(std::numeric_limits<std::size_t>::max());
+    finish_build();
+}
+
+// The build works on copies of the item spheres, the items can be moved, inserted and removed meanwhile
+void BoundingVolumeHierarchy::start_build()
+{
+    _build_items.clear();
+    for (BvhItemId id{}; id < _items.size(); ++id)
+    {
+        const Item &item{_items[id]};
+        if (item.is_alive)
+            _build_items.push_back({item.center, item.radius, id, item.generation});
+    }
+
+    _build_nodes.clear();
+    _build_node_parent_indexes.clear();
+    _build_tasks.clear();
+    if (!_build_items.empty())
+    {
+        std::uint32_t end_index{static_cast<std::uint32_t>(_build_items.size())};
+        _build_tasks.push_back({.end_index = end_index, .parent_index = NO_INDEX});
+    }
+    _is_building = true;
+}
+
+bool BoundingVolumeHierarchy::continue_build(std::size_t max_item_count)
+{
+    std::size_t built_item_count{};
+    while (!_build_tasks.empty() && built_item_count < max_item_count)
+    {
+        BuildTask task{_build_tasks.back()};
+        _build_tasks.pop_back();
+        built_item_count += task.end_index - task.begin_index;
+        build_node(task);
+    }
+    return _build_tasks.empty();
+}
+
+// The items changed during the build take their current sphere, the removed ones are left in the tree
+// with an infinitely negative radius, then the leaves of both are refitted.
+// The items inserted during the build stay pending, the others all get their new indexes
+void BoundingVolumeHierarchy::finish_build()
+{
+    _nodes.swap(_build_nodes);
+    _node_parent_indexes.swap(_build_node_parent_indexes);
+    _is_building = false;
+
+    _free_item_ids.insert(_free_item_ids.end(), _removed_item_ids.begin(), _removed_item_ids.end());
+    _removed_item_ids.clear();
+
+    _tree_cost = 0.0;
+    for (const Node &node : _nodes)
+        _tree_cost += get_half_surface_area(node.bounds);
+    _built_tree_cost = _tree_cost;
+    _dirty_node_bits.assign((_nodes.size() + 63) / 64, 0);
+    _has_dirty_nodes = false;
+
+    _tree_item_spheres.resize(_build_items.size());
+    _tree_item_values.resize(_build_items.size());
+    for (std::uint32_t node_index{}; node_index < _nodes.size(); ++node_index)
+    {
+        const Node &node{_nodes[node_index]};
+        if (node.right_child_index != 0)
+            continue;
+
+        for (std::uint32_t index{node.item_begin_index}; index < node.item_end_index; ++index)
+        {
+            const BuildItem &build_item{_build_items[index]};
+            Item &item{_items[build_item.id]};
+            if (!item.is_alive || item.generation != build_item.generation)
+            {
+                _tree_item_spheres.set(index, build_item.center, -std::numeric_limits<float>::infinity());
+                mark_dirty(node_index);
+                continue;
+            }
+
+            item.leaf_index = node_index;
+            item.tree_item_index = index;
+            _tree_item_spheres.set(index, item.center, item.radius);
+            _tree_item_values[index] = item.value;
+            bool has_moved{
+                item.center.x != build_item.center.x || item.center.y != build_item.center.y ||
+                item.center.z != build_item.center.z || item.radius != build_item.radius
+            };
+            if (has_moved)
+                mark_dirty(node_index);
+        }
+    }
+    std::erase_if(_pending_item_ids, [&](BvhItemId id) { return _items[id].tree_item_index != NO_INDEX; });
+    refit();
+}
+
+// The left child is built right after its parent, so the nodes stay in depth first order
+void BoundingVolumeHierarchy::build_node(const BuildTask &task)
+{
+    auto [begin_index, end_index, depth, parent_index, is_right_child] = task;
+    std::uint32_t node_index{static_cast<std::uint32_t>(_build_nodes.size())};
+    _build_nodes.emplace_back();
+    _build_node_parent_indexes.push_back(parent_index);
+    if (is_right_child)
+        _build_nodes[parent_index].right_child_index = node_index;
+
+    Aabb bounds{};
+    Aabb centroid_bounds{};
+    for (std::uint32_t index{begin_index}; index < end_index; ++index)
+    {
+        const BuildItem &build_item{_build_items[index]};
+        expand(bounds, get_sphere_aabb(build_item.center, build_item.radius));
+        expand(centroid_bounds, {build_item.center, build_item.center});
+    }
+    _build_nodes[node_index] = {.bounds = bounds, .item_begin_index = begin_index, .item_end_index = end_index};
+
+    std::uint32_t item_count{end_index - begin_index};
+    if (item_count <= 1 || depth >= MAX_DEPTH)
+        return;
+
+    float centroid_extents[3]{
+        centroid_bounds.max.x - centroid_bounds.min.x,
+        centroid_bounds.max.y - centroid_bounds.min.y,
+        centroid_bounds.max.z - centroid_bounds.min.z
+    };
+    std::size_t axis{2};
+    if (centroid_extents[0] >= centroid_extents[1] && centroid_extents[0] >= centroid_extents[2])
+        axis = 0;
+    else if (centroid_extents[1] >= centroid_extents[2])
+        axis = 1;
+
+    std::uint32_t middle_index;
+    // Also catches the infinite extents of overflowing centroids
+    if (!(centroid_extents[axis] > MIN_CENTROID_EXTENT && centroid_extents[axis] <= std::numeric_limits<float>::max()))
+    {
+        // All the centroids are about identical, the items are split in two arbitrary halves
+        if (item_count <= MAX_LEAF_ITEM_COUNT)
+            return;
+        middle_index = begin_index + item_count / 2;
+    }
+    else
+    {
+        struct Bin
+        {
+            Aabb bounds{};
+            std::uint32_t item_count{};
+        };
+
+        float axis_min{get_axis_component(centroid_bounds.min, axis)};
+        float bin_scale{BIN_COUNT / centroid_extents[axis]};
+        auto get_bin_index = [&](const BuildItem &build_item) {
+            float bin_position{(get_axis_component(build_item.center, axis) - axis_min) * bin_scale};
+            return std::min(BIN_COUNT - 1, static_cast<std::uint32_t>(bin_position));
+        };
+
+        std::array<Bin, BIN_COUNT> bins{};
+        for (std::uint32_t index{begin_index}; index < end_index; ++index)
+        {
+            const BuildItem &build_item{_build_items[index]};
+            Bin &bin{bins[get_bin_index(build_item)]};
+            expand(bin.bounds, get_sphere_aabb(build_item.center, build_item.radius));
+            ++bin.item_count;
+        }
+
+        // right_costs[index] is the cost of the items of the bins after index
+        std::array<float, BIN_COUNT> right_costs{};
+        Aabb right_bounds{};
+        std::uint32_t right_item_count{};
+        for (std::uint32_t bin_index{BIN_COUNT - 1}; bin_index > 0; --bin_index)
+        {
+            expand(right_bounds, bins[bin_index].bounds);
+            right_item_count += bins[bin_index].item_count;
+            right_costs[bin_index - 1] = right_item_count * get_half_surface_area(right_bounds);
+        }
+
+        float best_split_cost{std::numeric_limits<float>::infinity()};
+        std::uint32_t best_bin_index{};
+        Aabb left_bounds{};
+        std::uint32_t left_item_count{};
+        for (std::uint32_t bin_index{}; bin_index < BIN_COUNT - 1; ++bin_index)
+        {
+            expand(left_bounds, bins[bin_index].bounds);
+            left_item_count += bins[bin_index].item_count;
+            if (left_item_count == 0 || left_item_count == item_count)
+                continue;
+
+            float split_cost{left_item_count * get_half_surface_area(left_bounds) + right_costs[bin_index]};
+            if (split_cost < best_split_cost)
+            {
+                best_split_cost = split_cost;
+                best_bin_index = bin_index;
+            }
+        }
+
+        float bounds_area{get_half_surface_area(bounds)};
+        float leaf_cost{item_count * bounds_area};
+        if (item_count <= MAX_LEAF_ITEM_COUNT && leaf_cost <= TRAVERSAL_COST * bounds_area + best_split_cost)
+            return;
+
+        auto middle_it = std::partition(
+            _build_items.begin() + begin_index,
+            _build_items.begin() + end_index,
+            [&](const BuildItem &build_item) { return get_bin_index(build_item) <= best_bin_index; }
+        );
+        middle_index = static_cast<std::uint32_t>(middle_it - _build_items.begin());
+    }
+
+    _build_tasks.push_back({middle_index, end_index, depth + 1, node_index, true});
+    _build_tasks.push_back({begin_index, middle_index, depth + 1, node_index, false});
+}
+
+void BoundingVolumeHierarchy::mark_dirty(std::uint32_t node_index)
+{
+    for (; node_index != NO_INDEX; node_index = _node_parent_indexes[node_index])
+    {
+        std::uint64_t &dirty_node_bits{_dirty_node_bits[node_index / 64]};
+        std::uint64_t node_bit{std::uint64_t{1} << (node_index % 64)};
+        if (dirty_node_bits & node_bit)
+            break;
+        dirty_node_bits |= node_bit;
+    }
+    _has_dirty_nodes = true;
+}
+
+// Children are stored after their parent so a reverse sweep refits them first,
+// the set bits are iterated directly as most nodes stay clean
+void BoundingVolumeHierarchy::refit()
+{
+    if (!_has_dirty_nodes)
+        return;
+
+    for (std::size_t word_index{_dirty_node_bits.size()}; word_index-- > 0;)
+    {
+        std::uint64_t dirty_node_bits{_dirty_node_bits[word_index]};
+        _dirty_node_bits[word_index] = 0;
+        while (dirty_node_bits != 0)
+        {
+            std::uint32_t bit_index{63U - static_cast<std::uint32_t>(std::countl_zero(dirty_node_bits))};
+            dirty_node_bits &= ~(std::uint64_t{1} << bit_index);
+            refit_node(static_cast<std::uint32_t>(word_index * 64 + bit_index));
+        }
+    }
+    _has_dirty_nodes = false;
+}
+
+void BoundingVolumeHierarchy::refit_node(std::uint32_t node_index)
+{
+    Node &node{_nodes[node_index]};
+    _tree_cost -= get_half_surface_area(node.bounds);
+    if (node.right_child_index == 0)
+    {
+        node.bounds = {};
+        for (std::uint32_t index{node.item_begin_index}; index < node.item_end_index; ++index)
+        {
+            float radius{_tree_item_spheres.radius(index)};
+            if (radius >= 0.0f)
+                expand(node.bounds, get_sphere_aabb(_tree_item_spheres.center(index), radius));
+        }
+    }
+    else
+    {
+        node.bounds = _nodes[node_index + 1].bounds;
+        expand(node.bounds, _nodes[node.right_child_index].bounds);
+    }
+    _tree_cost += get_half_surface_area(node.bounds);
+}
+
+void BoundingVolumeHierarchy::append_tree_items(
+    std::uint32_t begin_index, std::uint32_t end_index, std::vector<std::uint32_t> &values
+) const
+{
+    for (std::uint32_t index{begin_index}; index < end_index; ++index)
+    {
+        if (_tree_item_spheres.radius(index) >= 0.0f)
+            values.push_back(_tree_item_values[index]);
+    }
+}
+
+void BoundingVolumeHierarchy::query_frustum(const Frustum &frustum, std::vector<std::uint32_t> &values) const
+{
+    std::array<std::uint32_t, MAX_DEPTH + 2> node_index_stack;
+    std::array<std::uint8_t, MAX_DEPTH + 2> plane_mask_stack;
+    std::size_t stack_size{};
+    if (!_nodes.empty())
+    {
+        node_index_stack[0] = 0;
+        plane_mask_stack[0] = ALL_PLANES_MASK;
+        stack_size = 1;
+    }
+
+    while (stack_size != 0)
+    {
+        --stack_size;
+        std::uint32_t node_index{node_index_stack[stack_size]};
+        std::uint8_t plane_mask{plane_mask_stack[stack_size]};
+        const Node &node{_nodes[node_index]};
+        if (!intersect_frustum(frustum, node.bounds, plane_mask))
+            continue;
+
+        // Subtrees entirely inside the frustum are accepted without further tests
+        if (plane_mask == 0)
+        {
+            append_tree_items(node.item_begin_index, node.item_end_index, values);
+            continue;
+        }
+
+        if (node.right_child_index == 0)
+        {
+            // The removed items are culled by their negative radius
+            std::size_t first_value_index{values.size()};
+            cull_bounding_spheres(frustum, _tree_item_spheres, node.item_begin_index, node.item_end_index, values);
+            for (std::size_t value_index{first_value_index}; value_index < values.size(); ++value_index)
+                values[value_index] = _tree_item_values[values[value_index]];
+            continue;
+        }
+
+        node_index_stack[stack_size] = node.right_child_index;
+        plane_mask_stack[stack_size++] = plane_mask;
+        node_index_stack[stack_size] = node_index + 1;
+        plane_mask_stack[stack_size++] = plane_mask;
+    }
+
+    for (BvhItemId id : _pending_item_ids)
+    {
+        const Item &item{_items[id]};
+        if (is_sphere_visible(frustum, item.center, item.radius))
+            values.push_back(item.value);
+    }
+}
+
+void BoundingVolumeHierarchy::query_radius(
+    const Math::Vector3 &center, float radius, std::vector<std::uint32_t> &values
+) const
+{
+    auto is_in_range = [&](const Math::Vector3 &item_center, float item_radius) {
+        float max_distance{radius + item_radius};
+        return item_radius >= 0.0f && get_squared_distance(item_center, center) <= max_distance * max_distance;
+    };
+
+    std::array<std::uint32_t, MAX_DEPTH + 2> node_index_stack;
+    std::size_t stack_size{};
+    if (!_nodes.empty())
+        node_index_stack[stack_size++] = 0;
+
+    while (stack_size != 0)
+    {
+        std::uint32_t node_index{node_index_stack[--stack_size]};
+        const Node &node{_nodes[node_index]};
+        if (!intersect_sphere(node.bounds, center, radius))
+            continue;
+
+        if (node.right_child_index == 0)
+        {
+            for (std::uint32_t index{node.item_begin_index}; index < node.item_end_index; ++index)
+            {
+                if (is_in_range(_tree_item_spheres.center(index), _tree_item_spheres.radius(index)))
+                    values.push_back(_tree_item_values[index]);
+            }
+            continue;
+        }
+
+        node_index_stack[stack_size++] = node.right_child_index;
+        node_index_stack[stack_size++] = node_index + 1;
+    }
+
+    for (BvhItemId id : _pending_item_ids)
+    {
+        const Item &item{_items[id]};
+        if (is_in_range(item.center, item.radius))
+            values.push_back(item.value);
+    }
+}
+
+void BoundingVolumeHierarchy::query_ray(
+    const Math::Vector3 &origin,
+    const Math::Vector3 &direction,
+    float max_distance,
+    std::vector<std::uint32_t> &values
+) const
+{
+    Math::Vector3 normalized_direction{Math::normalize(direction)};
+    Ray ray{
+        .origin = origin,
+        .direction = normalized_direction,
+        .inverse_direction{
+            1.0f / normalized_direction.x, 1.0f / normalized_direction.y, 1.0f / normalized_direction.z
+        },
+        .max_distance = max_distance
+    };
+
+    std::array<std::uint32_t, MAX_DEPTH + 2> node_index_stack;
+    std::size_t stack_size{};
+    if (!_nodes.empty())
+        node_index_stack[stack_size++] = 0;
+
+    while (stack_size != 0)
+    {
+        std::uint32_t node_index{node_index_stack[--stack_size]};
+        const Node &node{_nodes[node_index]};
+        if (!intersect_ray(node.bounds, ray))
+            continue;
+
+        if (node.right_child_index == 0)
+        {
+            for (std::uint32_t index{node.item_begin_index}; index < node.item_end_index; ++index)
+            {
+                float item_radius{_tree_item_spheres.radius(index)};
+                if (item_radius >= 0.0f && intersect_ray(_tree_item_spheres.center(index), item_radius, ray))
+                    values.push_back(_tree_item_values[index]);
+            }
+            continue;
+        }
+
+        node_index_stack[stack_size++] = node.right_child_index;
+        node_index_stack[stack_size++] = node_index + 1;
+    }
+
+    for (BvhItemId id : _pending_item_ids)
+    {
+        const Item &item{_items[id]};
+        if (intersect_ray(item.center, item.radius, ray))
+            values.push_back(item.value);
+    }
+}
+} // namespace Age::Gfx
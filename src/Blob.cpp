@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <bit>
+
+#include "Blob.hpp"
+#include "ErrorHandling.hpp"
+
+namespace Age::Core
+{
+namespace
+{
+constexpr std::size_t PAGE_INDEX_SHIFT{16};
+constexpr std::size_t OFFSET_SHIFT{4};
+constexpr std::uint32_t SIZE_CLASS_MASK{(1U << OFFSET_SHIFT) - 1};
+
+// The header of a blob takes the first aligned slot of its allocation
+constexpr std::size_t HEADER_SIZE{BLOB_ALIGNMENT};
+
+constexpr std::size_t get_size_class_size(std::size_t size_class)
+{
+    return BLOB_ALIGNMENT << size_class;
+}
+
+constexpr std::size_t get_size_class(std::size_t size)
+{
+    return static_cast<std::size_t>(std::bit_width((std::max(size, BLOB_ALIGNMENT) - 1) / BLOB_ALIGNMENT));
+}
+
+constexpr BlobId to_blob_id(std::size_t page_index, std::size_t offset, std::size_t size_class)
+{
+    return static_cast<BlobId>(
+        (page_index + 1) << PAGE_INDEX_SHIFT | (offset / BLOB_ALIGNMENT) << OFFSET_SHIFT | size_class
+    );
+}
+
+constexpr std::size_t get_page_index(BlobId id)
+{
+    return (static_cast<std::uint32_t>(id) >> PAGE_INDEX_SHIFT) - 1;
+}
+
+constexpr std::size_t get_offset(BlobId id)
+{
+    return ((static_cast<std::uint32_t>(id) & ((1U << PAGE_INDEX_SHIFT) - 1)) >> OFFSET_SHIFT) * BLOB_ALIGNMENT;
+}
+
+constexpr std::size_t get_size_class(BlobId id)
+{
+    return static_cast<std::uint32_t>(id) & SIZE_CLASS_MASK;
+}
+} // namespace
+
+BlobArena g_blob_arena{};
+
+BlobArena::~BlobArena()
+{
+    for (std::byte *page : _pages)
+        Memory::free_pages(page, BLOB_PAGE_SIZE);
+}
+
+BlobArena::BlobHeader &BlobArena::get_header(BlobId id) const
+{
+    return *reinterpret_cast<BlobHeader *>(_pages[get_page_index(id)] + get_offset(id));
+}
+
+BlobId BlobArena::allocate(EntityId owner_entity_id, std::size_t size)
+{
+    std::size_t size_class{get_size_class(HEADER_SIZE + size)};
+    VBAIL_ERROR_IF(size_class >= SIZE_CLASS_COUNT, BlobId{}, "Blob of {} bytes is larger than a blob page", size);
+
+    BlobId id{};
+    if (!_free_blob_ids[size_class].empty())
+    {
+        id = _free_blob_ids[size_class].back();
+        _free_blob_ids[size_class].pop_back();
+    }
+    else
+    {
+        std::size_t slot_size{get_size_class_size(size_class)};
+        // Slots are aligned on their size so a page tail too small for the slot is left unused
+        std::size_t offset{(_page_next_free_offset + slot_size - 1) / slot_size * slot_size};
+        if (offset + slot_size > BLOB_PAGE_SIZE)
+        {
+            VBAIL_ERROR_IF(_pages.size() >= (1U << PAGE_INDEX_SHIFT) - 1, BlobId{}, "Blob page count exceeded");
+
+            auto *page = static_cast<std::byte *>(Memory::allocate_pages(BLOB_PAGE_SIZE, false));
+            if (page == nullptr)
+                return BlobId{};
+
+            _pages.emplace_back(page);
+            offset = 0;
+        }
+        _page_next_free_offset = offset + slot_size;
+
+        id = to_blob_id(_pages.size() - 1, offset, size_class);
+    }
+
+    std::size_t entity_index{get_entity_location_index(owner_entity_id)};
+    if (entity_index >= _entity_first_blob_ids.size())
+        _entity_first_blob_ids.resize(entity_index + 1);
+
+    BlobHeader &header{get_header(id)};
+    header.next_owned_blob_id = _entity_first_blob_ids[entity_index];
+    header.size = static_cast<std::uint32_t>(size);
+    _entity_first_blob_ids[entity_index] = id;
+
+    _used_size += size;
+    return id;
+}
+
+void BlobArena::free_entity_blobs(EntityId owner_entity_id)
+{
+    std::size_t entity_index{get_entity_location_index(owner_entity_id)};
+    if (entity_index >= _entity_first_blob_ids.size())
+        return;
+
+    BlobId id{_entity_first_blob_ids[entity_index]};
+    while (id != BlobId{})
+    {
+        BlobHeader &header{get_header(id)};
+        _used_size -= header.size;
+        _free_blob_ids[get_size_class(id)].emplace_back(id);
+        id = header.next_owned_blob_id;
+    }
+    _entity_first_blob_ids[entity_index] = BlobId{};
+}
+
+void *BlobArena::get_data(BlobId id) const
+{
+    if (id == BlobId{})
+        return nullptr;
+
+    return _pages[get_page_index(id)] + get_offset(id) + HEADER_SIZE;
+}
+} // namespace Age::Core
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define AGE_CULLING_SSE
+#include <xmmintrin.h>
+#endif
+
+#include "Culling.hpp"
+#include "Transformations.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+Math::Vector4 normalize_plane(const Math::Vector4 &plane)
+{
+    return plane / Math::length(Math::Vector3{plane});
+}
+} // namespace
+
+void BoundingSpheres::reserve(std::size_t count)
+{
+    _spheres.reserve(count + 3);
+}
+
+void BoundingSpheres::resize(std::size_t count)
+{
+    _spheres.resize(count + 3);
+    _count = count;
+}
+
+void BoundingSpheres::clear()
+{
+    resize(0);
+}
+
+// Gribb and Hartmann plane extraction, for clip coordinates in [-w, w] on the three axes
+Frustum extract_frustum(const Math::Matrix4 &world_to_clip_matrix)
+{
+    Math::Vector4 row_x{world_to_clip_matrix.row(0)};
+    Math::Vector4 row_y{world_to_clip_matrix.row(1)};
+    Math::Vector4 row_z{world_to_clip_matrix.row(2)};
+    Math::Vector4 row_w{world_to_clip_matrix.row(3)};
+
+    return {{
+        normalize_plane(row_w + row_x),
+        normalize_plane(row_w - row_x),
+        normalize_plane(row_w + row_y),
+        normalize_plane(row_w - row_y),
+        normalize_plane(row_w + row_z),
+        normalize_plane(row_w - row_z),
+    }};
+}
+
+bool is_sphere_visible(const Frustum &frustum, const Math::Vector3 &center, float radius)
+{
+    for (const Math::Vector4 &plane : frustum.planes)
+    {
+        if (Math::dot(Math::Vector3{plane}, center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+void update_world_bounds(const Core::Transform &transform, const MeshRef &mesh, WorldBounds &world_bounds)
+{
+    const MeshBounds &mesh_bounds{get_mesh_bounds(mesh.mesh_id)};
+    if (mesh_bounds.radius < 0.0f)
+    {
+        world_bounds = {};
+        return;
+    }
+
+    Math::Matrix4 lw_matrix{Core::transform_matrix(transform)};
+    float max_scale{std::max({std::abs(transform.scale.x), std::abs(transform.scale.y), std::abs(transform.scale.z)})};
+
+    world_bounds.center = Math::Vector3{lw_matrix * Math::Vector4{mesh_bounds.center, 1.0f}};
+    world_bounds.radius = mesh_bounds.radius * max_scale;
+}
+
+void cull_bounding_spheres(
+    const Frustum &frustum,
+    const BoundingSpheres &spheres,
+    std::size_t begin_index,
+    std::size_t end_index,
+    std::vector<std::uint32_t> &visible_indexes
+)
+{
+#ifdef AGE_CULLING_SSE
+    __m128 plane_xs[6];
+    __m128 plane_ys[6];
+    __m128 plane_zs[6];
+    __m128 plane_ws[6];
+    for (std::size_t plane_index{}; plane_index < 6; ++plane_index)
+    {
+        const Math::Vector4 &plane{frustum.planes[plane_index]};
+        plane_xs[plane_index] = _mm_set1_ps(plane.x);
+        plane_ys[plane_index] = _mm_set1_ps(plane.y);
+        plane_zs[plane_index] = _mm_set1_ps(plane.z);
+        plane_ws[plane_index] = _mm_set1_ps(plane.w);
+    }
+
+    for (std::size_t index{begin_index}; index < end_index; index += 4)
+    {
+        __m128 center_xs{_mm_loadu_ps(&spheres._spheres[index].x)};
+        __m128 center_ys{_mm_loadu_ps(&spheres._spheres[index + 1].x)};
+        __m128 center_zs{_mm_loadu_ps(&spheres._spheres[index + 2].x)};
+        __m128 radiuses{_mm_loadu_ps(&spheres._spheres[index + 3].x)};
+        _MM_TRANSPOSE4_PS(center_xs, center_ys, center_zs, radiuses);
+        __m128 negated_radiuses{_mm_sub_ps(_mm_setzero_ps(), radiuses)};
+
+        // A sphere is outside as soon as its center is further than its radius behind one plane
+        __m128 outside_mask{_mm_setzero_ps()};
+        for (std::size_t plane_index{}; plane_index < 6; ++plane_index)
+        {
+            __m128 distances{_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(plane_xs[plane_index], center_xs), _mm_mul_ps(plane_ys[plane_index], center_ys)),
+                _mm_add_ps(_mm_mul_ps(plane_zs[plane_index], center_zs), plane_ws[plane_index])
+            )};
+            outside_mask = _mm_or_ps(outside_mask, _mm_cmplt_ps(distances, negated_radiuses));
+        }
+
+        int visible_mask{~_mm_movemask_ps(outside_mask) & 0b1111};
+        std::size_t lane_count{std::min<std::size_t>(4, end_index - index)};
+        for (std::size_t lane{}; lane < lane_count; ++lane)
+        {
+            if (visible_mask & (1 << lane))
+                visible_indexes.push_back(static_cast<std::uint32_t>(index + lane));
+        }
+    }
+#else
+    for (std::size_t index{begin_index}; index < end_index; ++index)
+    {
+        if (is_sphere_visible(frustum, spheres.center(index), spheres.radius(index)))
+            visible_indexes.push_back(static_cast<std::uint32_t>(index));
+    }
+#endif
+}
+} // namespace Age::Gfx
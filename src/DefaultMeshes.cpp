@@ -309,47 +309,38 @@ void create_cylinder_mesh(MeshBuffers &mesh_buffers, std::span<DrawCommand, 3> d
     }
     index_buffer[bottom_cap_index_offset + 1 + side_count] = static_cast<GLushort>(bottom_cap_vertex_offset + 1);
 
-    glGenBuffers(1, &mesh_buffers.vertex_buffer_object);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffers.vertex_buffer_object);
-    glBufferData(GL_ARRAY_BUFFER, vertex_count * 3 * sizeof(Vector3), vertex_buffer.get(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glGenBuffers(1, &mesh_buffers.index_buffer_object);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh_buffers.index_buffer_object);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(GLushort), index_buffer.get(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    glGenVertexArrays(1, &mesh_buffers.vertex_array_object);
-    glBindVertexArray(mesh_buffers.vertex_array_object);
-
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffers.vertex_buffer_object);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, false, 0, 0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(color_offset * sizeof(Vector3)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(normal_offset * sizeof(Vector3)));
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh_buffers.index_buffer_object);
-
-    glBindVertexArray(0);
+    create_elements_mesh(
+        vertex_buffer.get(),
+        vertex_buffer.get() + color_offset,
+        vertex_buffer.get() + normal_offset,
+        nullptr,
+        vertex_count,
+        index_buffer.get(),
+        index_count,
+        OGL::RenderingMode::TRIANGLE_STRIP,
+        mesh_buffers,
+        draw_commands[0]
+    );
 
-    draw_commands[0] = DrawCommand{
-        .type{DrawCommandType::DRAW_ELEMENTS},
-        .rendering_mode{OGL::RenderingMode::TRIANGLE_STRIP},
-        .element_count{static_cast<std::uint32_t>((side_count + 1) * 2)},
-        .offset{0}
-    };
+    // The side strip and the cap fans follow each other in the index buffer
+    std::size_t index_offset{draw_commands[0].offset};
+    std::size_t index_size{OGL::get_index_size(draw_commands[0].index_type)};
+    draw_commands[0].element_count = static_cast<std::uint32_t>((side_count + 1) * 2);
     draw_commands[1] = DrawCommand{
         .type{DrawCommandType::DRAW_ELEMENTS},
         .rendering_mode{OGL::RenderingMode::TRIANGLE_FAN},
         .element_count{static_cast<std::uint32_t>(side_count + 2)},
-        .offset{(side_count + 1) * 2 * sizeof(GLushort)}
+        .offset{index_offset + (side_count + 1) * 2 * index_size},
+        .base_vertex{draw_commands[0].base_vertex},
+        .index_type{draw_commands[0].index_type}
     };
     draw_commands[2] = DrawCommand{
         .type{DrawCommandType::DRAW_ELEMENTS},
         .rendering_mode{OGL::RenderingMode::TRIANGLE_FAN},
         .element_count{static_cast<std::uint32_t>(side_count + 2)},
-        .offset{((side_count + 1) * 2 + side_count + 2) * sizeof(GLushort)}
+        .offset{index_offset + ((side_count + 1) * 2 + side_count + 2) * index_size},
+        .base_vertex{draw_commands[0].base_vertex},
+        .index_type{draw_commands[0].index_type}
     };
 }
 
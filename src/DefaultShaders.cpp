@@ -2,33 +2,35 @@
 
 namespace Age::Gfx
 {
-UnlitShader::UnlitShader(GLuint shader_program)
-    : Shader{shader_program}
+UnlitShader::UnlitShader(GLuint shader_program, ShaderCommonUniforms common_uniforms)
+    : Shader{shader_program, common_uniforms}
 {
 }
 
-UnlitColorShader::UnlitColorShader(GLuint shader_program)
-    : UnlitShader{shader_program}
+UnlitColorShader::UnlitColorShader(GLuint shader_program, ShaderCommonUniforms common_uniforms)
+    : UnlitShader{shader_program, common_uniforms}
     , color{OGL::get_uniform_location(shader_program, "_color")}
 {
 }
 
 LitDiffuseTextureShader::LitDiffuseTextureShader(GLuint shader_program)
-    : Shader{shader_program, {.lv_normal_matrix = true}}
+    : Shader{shader_program, {.lw_matrix = false, .draw_block = true}}
     , light_block{OGL::get_uniform_block_index(shader_program, "LightBlock")}
     , sampler{OGL::get_uniform_location(shader_program, "_texture")}
 {
 }
 
-FragmentLightingShader::FragmentLightingShader(GLuint shader_program)
-    : Shader{shader_program, {.lv_normal_matrix = true}}
+FragmentLightingShader::FragmentLightingShader(GLuint shader_program, ShaderCommonUniforms common_uniforms)
+    : Shader{shader_program, common_uniforms}
     , specular_color{OGL::get_uniform_location(shader_program, "uSpecularColor")}
     , surface_shininess{OGL::get_uniform_location(shader_program, "uSurfaceShininess")}
 {
 }
 
-FragmentLightingColorShader::FragmentLightingColorShader(GLuint shader_program)
-    : FragmentLightingShader{shader_program}
+FragmentLightingColorShader::FragmentLightingColorShader(
+    GLuint shader_program, ShaderCommonUniforms common_uniforms
+)
+    : FragmentLightingShader{shader_program, common_uniforms}
     , diffuse_color{OGL::get_uniform_location(shader_program, "uDiffuseColor")}
 {
 }
@@ -1,7 +1,10 @@
 #include <cstring>
 #include <unordered_map>
 
+#include "Blob.hpp"
 #include "ECS.hpp"
+#include "ECSStats.hpp"
+#include "ErrorHandling.hpp"
 #include "Hash.hpp"
 
 #include "game/Game.hpp"
@@ -22,7 +25,9 @@ struct std::hash<std::span<const Age::Core::ComponentType>>
 
 namespace Age::Core
 {
-Memory::PoolAllocator<1U << 18, ARCHETYPE_CHUNK_SIZE> g_chunk_allocator{};
+ChunkAllocator<ChunkSizeClass::SMALL> g_small_chunk_allocator{true};
+ChunkAllocator<ChunkSizeClass::MEDIUM> g_medium_chunk_allocator{true};
+ChunkAllocator<ChunkSizeClass::LARGE> g_large_chunk_allocator{true};
 
 std::vector<Archetype> g_archetypes{};
 // Stored ArchetypeIds are +1
@@ -31,9 +36,14 @@ static std::unordered_map<std::size_t, ArchetypeId> s_component_types_to_archety
 std::vector<std::vector<ArchetypeId>> g_component_archetype_ids{};
 std::vector<std::vector<ComponentOffset>> g_component_archetype_offsets{};
 
-Util::IdGenerator<EntityId> g_entity_id_generator{1};
+EntityIdGenerator g_entity_id_generator{1};
 std::vector<EntityLocation> g_entity_locations{};
 
+std::vector<ComponentDestroyer> g_component_destroyers{};
+
+std::vector<QueryCounters> g_query_counters{};
+std::vector<std::vector<ComponentType>> g_query_component_types{};
+
 void init_ecs(const App::Definitions &definitions)
 {
     std::size_t component_type_count{
@@ -45,6 +55,7 @@ void init_ecs(const App::Definitions &definitions)
 
     g_component_archetype_ids.resize(component_type_count);
     g_component_archetype_offsets.resize(component_type_count);
+    g_component_destroyers.resize(component_type_count);
 
     for (std::size_t index{}; index < component_type_count; ++index)
     {
@@ -53,6 +64,11 @@ void init_ecs(const App::Definitions &definitions)
     }
 
     g_entity_locations.reserve(1ULL << 14);
+
+    g_query_counters.reserve(64);
+    g_query_component_types.reserve(64);
+
+    init_ecs_stats(definitions);
 }
 
 ArchetypeRef get_or_create_archetype(
@@ -76,6 +92,43 @@ ArchetypeRef get_or_create_archetype(
     }
 }
 
+void *allocate_chunk(ChunkSizeClass size_class)
+{
+    switch (size_class)
+    {
+    case ChunkSizeClass::SMALL:
+        return g_small_chunk_allocator.get_chunk();
+    case ChunkSizeClass::MEDIUM:
+        return g_medium_chunk_allocator.get_chunk();
+    default:
+        return g_large_chunk_allocator.get_chunk();
+    }
+}
+
+void free_chunk(ChunkSizeClass size_class, void *chunk)
+{
+    switch (size_class)
+    {
+    case ChunkSizeClass::SMALL:
+        g_small_chunk_allocator.return_chunk(chunk);
+        break;
+    case ChunkSizeClass::MEDIUM:
+        g_medium_chunk_allocator.return_chunk(chunk);
+        break;
+    default:
+        g_large_chunk_allocator.return_chunk(chunk);
+        break;
+    }
+}
+
+QueryId register_query(std::span<const ComponentType> component_types)
+{
+    QueryId query_id{static_cast<QueryId>(g_query_counters.size())};
+    g_query_counters.emplace_back();
+    g_query_component_types.emplace_back(component_types.begin(), component_types.end());
+    return query_id;
+}
+
 Archetype create_archetype(
     ArchetypeId archetype_id,
     std::span<const ComponentType> component_types,
@@ -92,25 +145,41 @@ Archetype create_archetype(
         entity_size += size;
     }
 
-    archetype.entity_count_per_chunk = static_cast<std::uint16_t>(ARCHETYPE_CHUNK_SIZE / entity_size);
+    // Every component array is 8 bytes aligned so each array loses at most 7 bytes to padding
+    std::size_t max_padding{7 * (component_sizes.size() + 1)};
+    std::size_t size_class_index{};
+    while (size_class_index < std::size(CHUNK_SIZES) - 1 &&
+           entity_size * MIN_ENTITY_COUNT_PER_CHUNK + max_padding > CHUNK_SIZES[size_class_index])
+    {
+        ++size_class_index;
+    }
+    std::size_t chunk_size{CHUNK_SIZES[size_class_index]};
+
+    archetype.chunk_size_class = static_cast<ChunkSizeClass>(size_class_index);
+    archetype.entity_count_per_chunk = static_cast<std::uint16_t>(chunk_size / entity_size);
 
+    std::size_t padding{};
     if (component_sizes.size() > 0)
     {
         while (true)
         {
-            std::size_t padding{padding_to<8>(sizeof(EntityId) * archetype.entity_count_per_chunk)};
+            padding = padding_to<8>(sizeof(EntityId) * archetype.entity_count_per_chunk);
             for (std::size_t index{}; index < component_sizes.size() - 1; ++index)
             {
                 padding += padding_to<8>(component_sizes[index] * archetype.entity_count_per_chunk);
             }
 
-            if (entity_size * archetype.entity_count_per_chunk + padding > ARCHETYPE_CHUNK_SIZE)
+            if (entity_size * archetype.entity_count_per_chunk + padding > chunk_size)
                 --archetype.entity_count_per_chunk;
             else
                 break;
         }
     }
 
+    archetype.entity_size = static_cast<std::uint16_t>(entity_size);
+    archetype.chunk_padding_size = static_cast<std::uint16_t>(padding);
+    archetype.component_types.assign(component_types.begin(), component_types.end());
+
     archetype.chunks.reserve(8);
 
     std::size_t in_chunk_offset{sizeof(EntityId) * archetype.entity_count_per_chunk};
@@ -123,10 +192,76 @@ Archetype create_archetype(
         g_component_archetype_offsets[component_type].emplace_back(static_cast<ComponentOffset>(in_chunk_offset));
 
         std::size_t component_size{component_sizes[index]};
+        archetype.component_sizes.emplace_back(static_cast<std::uint16_t>(component_size));
+        archetype.component_offsets.emplace_back(static_cast<ComponentOffset>(in_chunk_offset));
+
         in_chunk_offset += component_size * archetype.entity_count_per_chunk;
         in_chunk_offset += padding_to<8>(in_chunk_offset);
     }
 
     return archetype;
 }
+
+void destroy_entity(EntityId entity_id)
+{
+    BAIL_ERROR_IF(!is_entity_alive(entity_id), "Destroyed entity {} is not alive", entity_id);
+
+    if (!is_entity_created(entity_id))
+    {
+        g_blob_arena.free_entity_blobs(entity_id);
+        g_entity_id_generator.destroy(entity_id);
+        return;
+    }
+
+    EntityLocation entity_location{g_entity_locations[get_entity_location_index(entity_id)]};
+    Archetype &archetype{g_archetypes[entity_location.archetype_id]};
+
+    std::uint32_t last_entity_index{archetype.entity_count - 1};
+    char *chunk{static_cast<char *>(archetype.chunks[entity_location.entity_index / archetype.entity_count_per_chunk])};
+    char *last_chunk{static_cast<char *>(archetype.chunks.back())};
+    std::size_t chunk_entity_index{entity_location.entity_index % archetype.entity_count_per_chunk};
+    std::size_t last_chunk_entity_index{last_entity_index % archetype.entity_count_per_chunk};
+
+    for (std::size_t index{}; index < archetype.component_types.size(); ++index)
+    {
+        auto component_type{static_cast<std::size_t>(archetype.component_types[index])};
+        if (ComponentDestroyer destroyer{g_component_destroyers[component_type]}; destroyer != nullptr)
+        {
+            destroyer(
+                entity_id,
+                chunk + archetype.component_offsets[index] + chunk_entity_index * archetype.component_sizes[index]
+            );
+        }
+    }
+
+    if (entity_location.entity_index != last_entity_index)
+    {
+        EntityId *entity_id_array{reinterpret_cast<EntityId *>(chunk)};
+        EntityId *last_entity_id_array{reinterpret_cast<EntityId *>(last_chunk)};
+        EntityId moved_entity_id{last_entity_id_array[last_chunk_entity_index]};
+        entity_id_array[chunk_entity_index] = moved_entity_id;
+
+        for (std::size_t index{}; index < archetype.component_sizes.size(); ++index)
+        {
+            std::size_t size{archetype.component_sizes[index]};
+            std::size_t offset{archetype.component_offsets[index]};
+            std::memcpy(
+                chunk + offset + chunk_entity_index * size, last_chunk + offset + last_chunk_entity_index * size, size
+            );
+        }
+
+        g_entity_locations[get_entity_location_index(moved_entity_id)].entity_index = entity_location.entity_index;
+    }
+
+    --archetype.entity_count;
+    if (last_chunk_entity_index == 0)
+    {
+        free_chunk(archetype.chunk_size_class, last_chunk);
+        archetype.chunks.pop_back();
+    }
+
+    g_entity_locations[get_entity_location_index(entity_id)] = {};
+    g_blob_arena.free_entity_blobs(entity_id);
+    g_entity_id_generator.destroy(entity_id);
+}
 } // namespace Age::Core
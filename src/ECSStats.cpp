@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include "ECSStats.hpp"
+#include "ErrorHandling.hpp"
+
+namespace Age::Core
+{
+namespace
+{
+std::uint32_t s_dump_interval{};
+std::string_view s_dump_path{};
+
+std::uint64_t s_frame_index{};
+std::vector<QueryCounters> s_last_frame_query_counters{};
+
+std::string to_string(std::span<const ComponentType> component_types)
+{
+    std::string string{"["};
+    for (std::size_t index{}; index < component_types.size(); ++index)
+    {
+        if (index != 0)
+            string += ", ";
+        string += std::to_string(static_cast<std::size_t>(component_types[index]));
+    }
+    string += "]";
+    return string;
+}
+
+template <typename TAllocator>
+ChunkAllocatorStats get_chunk_allocator_stats(TAllocator &allocator)
+{
+    return {
+        .page_size = allocator.page_size(),
+        .chunk_size = allocator.chunk_size(),
+        .page_count = allocator.page_count(),
+        .used_chunk_count = allocator.used_chunk_count(),
+        .free_chunk_count = allocator.free_chunk_count()
+    };
+}
+
+void dump_ecs_stats()
+{
+    EcsStats stats{get_ecs_stats()};
+
+    if (s_dump_path.empty())
+        log_ecs_stats(stats);
+    else
+        write_ecs_stats(stats, s_dump_path);
+}
+} // namespace
+
+void init_ecs_stats(const App::Definitions &definitions)
+{
+    s_dump_interval = definitions.ecs_stats_dump_interval;
+    s_dump_path = definitions.ecs_stats_dump_path;
+
+    s_last_frame_query_counters.reserve(64);
+}
+
+EcsStats get_ecs_stats()
+{
+    EcsStats stats{.frame_index = s_frame_index};
+
+    stats.archetypes.reserve(g_archetypes.size());
+    std::size_t entity_slot_count{};
+    for (std::size_t index{}; index < g_archetypes.size(); ++index)
+    {
+        const Archetype &archetype{g_archetypes[index]};
+
+        std::size_t chunk_count{archetype.chunks.size()};
+        std::size_t chunk_entity_slot_count{chunk_count * archetype.entity_count_per_chunk};
+        float fill_ratio{};
+        if (chunk_entity_slot_count != 0)
+            fill_ratio = static_cast<float>(archetype.entity_count) / chunk_entity_slot_count;
+        std::size_t chunk_size{get_chunk_size(archetype.chunk_size_class)};
+        std::size_t chunk_tail_size{
+            chunk_size - archetype.entity_size * archetype.entity_count_per_chunk - archetype.chunk_padding_size
+        };
+
+        stats.archetypes.push_back({
+            .archetype_id = static_cast<ArchetypeId>(index),
+            .component_types = archetype.component_types,
+            .entity_count = archetype.entity_count,
+            .chunk_count = static_cast<std::uint32_t>(chunk_count),
+            .chunk_size = chunk_size,
+            .entity_count_per_chunk = archetype.entity_count_per_chunk,
+            .entity_size = archetype.entity_size,
+            .chunk_padding_size = archetype.chunk_padding_size,
+            .chunk_tail_size = chunk_tail_size,
+            .fill_ratio = fill_ratio
+        });
+
+        stats.entity_count += archetype.entity_count;
+        stats.used_chunk_size += archetype.entity_count * archetype.entity_size;
+        stats.wasted_chunk_size += chunk_count * (archetype.chunk_padding_size + chunk_tail_size) +
+                                   (chunk_entity_slot_count - archetype.entity_count) * archetype.entity_size;
+        entity_slot_count += chunk_entity_slot_count;
+    }
+    stats.fill_ratio = entity_slot_count == 0 ? 0.0f : static_cast<float>(stats.entity_count) / entity_slot_count;
+
+    stats.queries.reserve(s_last_frame_query_counters.size());
+    for (std::size_t index{}; index < s_last_frame_query_counters.size(); ++index)
+    {
+        stats.queries.push_back({
+            .query_id = static_cast<QueryId>(index),
+            .component_types = g_query_component_types[index],
+            .counters = s_last_frame_query_counters[index]
+        });
+    }
+
+    stats.chunk_allocators = {
+        get_chunk_allocator_stats(g_small_chunk_allocator),
+        get_chunk_allocator_stats(g_medium_chunk_allocator),
+        get_chunk_allocator_stats(g_large_chunk_allocator)
+    };
+
+    // Entity indexes start at 1
+    stats.generated_entity_id_count = get_entity_location_index(g_entity_id_generator.next_id());
+    stats.free_entity_id_count = g_entity_id_generator.free_id_count();
+
+    return stats;
+}
+
+void log_ecs_stats(const EcsStats &stats)
+{
+    log_info(
+        "ECS stats at frame {}: {} entities, {} archetypes, fill ratio {:.3f}, {} used bytes, {} wasted bytes",
+        stats.frame_index,
+        stats.entity_count,
+        stats.archetypes.size(),
+        stats.fill_ratio,
+        stats.used_chunk_size,
+        stats.wasted_chunk_size
+    );
+    for (const ChunkAllocatorStats &chunk_allocator : stats.chunk_allocators)
+    {
+        log_info(
+            "  chunk allocator: {} pages of {} bytes, {} used chunks and {} free chunks of {} bytes",
+            chunk_allocator.page_count,
+            chunk_allocator.page_size,
+            chunk_allocator.used_chunk_count,
+            chunk_allocator.free_chunk_count,
+            chunk_allocator.chunk_size
+        );
+    }
+    log_info("  entity ids: {} generated, {} free", stats.generated_entity_id_count, stats.free_entity_id_count);
+
+    for (const ArchetypeStats &archetype : stats.archetypes)
+    {
+        log_info(
+            "  archetype {} {}: {} entities in {} chunks of {} bytes ({} per chunk, {} bytes each), "
+            "fill ratio {:.3f}, {} padding bytes and {} tail bytes per chunk",
+            archetype.archetype_id,
+            to_string(archetype.component_types),
+            archetype.entity_count,
+            archetype.chunk_count,
+            archetype.chunk_size,
+            archetype.entity_count_per_chunk,
+            archetype.entity_size,
+            archetype.fill_ratio,
+            archetype.chunk_padding_size,
+            archetype.chunk_tail_size
+        );
+    }
+
+    for (const QueryStats &query : stats.queries)
+    {
+        log_info(
+            "  query {} {}: {} calls, {} archetypes, {} entities",
+            query.query_id,
+            to_string(query.component_types),
+            query.counters.call_count,
+            query.counters.archetype_count,
+            query.counters.entity_count
+        );
+    }
+}
+
+bool write_ecs_stats(const EcsStats &stats, std::string_view file_path)
+{
+    std::ofstream file{std::string{file_path}, std::ios_base::trunc};
+    VBAIL_ERROR_IF(!file, false, "ECS stats file opening failed: {}", file_path);
+
+    file << "{\n";
+    file << "  \"frame_index\": " << stats.frame_index << ",\n";
+    file << "  \"entity_count\": " << stats.entity_count << ",\n";
+    file << "  \"generated_entity_id_count\": " << stats.generated_entity_id_count << ",\n";
+    file << "  \"free_entity_id_count\": " << stats.free_entity_id_count << ",\n";
+    file << "  \"used_chunk_size\": " << stats.used_chunk_size << ",\n";
+    file << "  \"wasted_chunk_size\": " << stats.wasted_chunk_size << ",\n";
+    file << "  \"fill_ratio\": " << stats.fill_ratio << ",\n";
+
+    file << "  \"chunk_allocators\": [";
+    for (std::size_t index{}; index < stats.chunk_allocators.size(); ++index)
+    {
+        const ChunkAllocatorStats &chunk_allocator{stats.chunk_allocators[index]};
+        file << (index == 0 ? "\n" : ",\n");
+        file << "    {\"page_size\": " << chunk_allocator.page_size;
+        file << ", \"chunk_size\": " << chunk_allocator.chunk_size;
+        file << ", \"page_count\": " << chunk_allocator.page_count;
+        file << ", \"used_chunk_count\": " << chunk_allocator.used_chunk_count;
+        file << ", \"free_chunk_count\": " << chunk_allocator.free_chunk_count << "}";
+    }
+    file << "\n  ],\n";
+
+    file << "  \"archetypes\": [";
+    for (std::size_t index{}; index < stats.archetypes.size(); ++index)
+    {
+        const ArchetypeStats &archetype{stats.archetypes[index]};
+        file << (index == 0 ? "\n" : ",\n");
+        file << "    {\"archetype_id\": " << archetype.archetype_id;
+        file << ", \"component_types\": " << to_string(archetype.component_types);
+        file << ", \"entity_count\": " << archetype.entity_count;
+        file << ", \"chunk_count\": " << archetype.chunk_count;
+        file << ", \"chunk_size\": " << archetype.chunk_size;
+        file << ", \"entity_count_per_chunk\": " << archetype.entity_count_per_chunk;
+        file << ", \"entity_size\": " << archetype.entity_size;
+        file << ", \"chunk_padding_size\": " << archetype.chunk_padding_size;
+        file << ", \"chunk_tail_size\": " << archetype.chunk_tail_size;
+        file << ", \"fill_ratio\": " << archetype.fill_ratio << "}";
+    }
+    file << "\n  ],\n";
+
+    file << "  \"queries\": [";
+    for (std::size_t index{}; index < stats.queries.size(); ++index)
+    {
+        const QueryStats &query{stats.queries[index]};
+        file << (index == 0 ? "\n" : ",\n");
+        file << "    {\"query_id\": " << query.query_id;
+        file << ", \"component_types\": " << to_string(query.component_types);
+        file << ", \"call_count\": " << query.counters.call_count;
+        file << ", \"archetype_count\": " << query.counters.archetype_count;
+        file << ", \"entity_count\": " << query.counters.entity_count << "}";
+    }
+    file << "\n  ]\n";
+    file << "}\n";
+
+    VBAIL_ERROR_IF(!file, false, "ECS stats file writing failed: {}", file_path);
+    return true;
+}
+
+void update_ecs_stats()
+{
+    s_last_frame_query_counters.assign(g_query_counters.begin(), g_query_counters.end());
+    std::fill(g_query_counters.begin(), g_query_counters.end(), QueryCounters{});
+
+    ++s_frame_index;
+
+    if (s_dump_interval != 0 && s_frame_index % s_dump_interval == 0)
+        dump_ecs_stats();
+}
+} // namespace Age::Core
@@ -0,0 +1,225 @@
+#if defined(AGE_HEADLESS_EGL) && !defined(AGE_RECORDING_OGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "ErrorHandling.hpp"
+#include "Headless.hpp"
+#include "Logging.hpp"
+#include "OpenGL.hpp"
+#include "RecordingOpenGL.hpp"
+
+namespace Age::Gfx
+{
+#if defined(AGE_RECORDING_OGL)
+// The recorded calls need no context nor framebuffer
+bool create_headless_context(unsigned int, unsigned int)
+{
+    VBAIL_ERROR_IF(OGL::load_recording_functions() == false, false, "OpenGL recording functions loading failed");
+    Core::log_info("recording OpenGL calls (headless)");
+    return true;
+}
+
+void destroy_headless_context()
+{
+}
+
+void finish_headless_frame()
+{
+}
+#elif defined(AGE_HEADLESS_EGL)
+namespace
+{
+EGLDisplay s_display{EGL_NO_DISPLAY};
+EGLSurface s_surface{EGL_NO_SURFACE};
+EGLContext s_context{EGL_NO_CONTEXT};
+
+GLuint s_framebuffer{};
+GLuint s_color_renderbuffer{};
+GLuint s_depth_renderbuffer{};
+
+// The surfaceless platform of Mesa needs no display server, the default display is the fallback
+EGLDisplay get_display()
+{
+    auto get_platform_display{
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"))
+    };
+    if (get_platform_display != nullptr)
+    {
+        EGLDisplay display{get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)};
+        if (display != EGL_NO_DISPLAY)
+            return display;
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool create_context(unsigned int framebuffer_width, unsigned int framebuffer_height)
+{
+    s_display = get_display();
+    VBAIL_ERROR_IF(s_display == EGL_NO_DISPLAY, false, "EGL display retrieval failed");
+
+    EGLint major_version{};
+    EGLint minor_version{};
+    VBAIL_ERROR_IF(
+        eglInitialize(s_display, &major_version, &minor_version) == EGL_FALSE, false, "EGL initialization failed"
+    );
+    Core::log_info("initialized EGL {}.{}", major_version, minor_version);
+
+    const EGLint config_attributes[]{
+        EGL_SURFACE_TYPE,
+        EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,
+        EGL_OPENGL_BIT,
+        EGL_NONE,
+    };
+    EGLConfig config{};
+    EGLint config_count{};
+    VBAIL_ERROR_IF(
+        eglChooseConfig(s_display, config_attributes, &config, 1, &config_count) == EGL_FALSE || config_count == 0,
+        false,
+        "EGL config selection failed"
+    );
+
+    VBAIL_ERROR_IF(eglBindAPI(EGL_OPENGL_API) == EGL_FALSE, false, "EGL OpenGL API binding failed");
+
+    const EGLint context_attributes[]{
+        EGL_CONTEXT_MAJOR_VERSION,
+        3,
+        EGL_CONTEXT_MINOR_VERSION,
+        3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK,
+        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+    s_context = eglCreateContext(s_display, config, EGL_NO_CONTEXT, context_attributes);
+    VBAIL_ERROR_IF(s_context == EGL_NO_CONTEXT, false, "EGL context creation failed");
+
+    // Contexts are made current without surface when EGL_KHR_surfaceless_context is available,
+    // the pbuffer is never drawn to as the rendering goes to the offscreen framebuffer
+    if (eglMakeCurrent(s_display, EGL_NO_SURFACE, EGL_NO_SURFACE, s_context) == EGL_FALSE)
+    {
+        const EGLint surface_attributes[]{
+            EGL_WIDTH,
+            static_cast<EGLint>(framebuffer_width),
+            EGL_HEIGHT,
+            static_cast<EGLint>(framebuffer_height),
+            EGL_NONE,
+        };
+        s_surface = eglCreatePbufferSurface(s_display, config, surface_attributes);
+        VBAIL_ERROR_IF(s_surface == EGL_NO_SURFACE, false, "EGL pbuffer creation failed");
+        VBAIL_ERROR_IF(
+            eglMakeCurrent(s_display, s_surface, s_surface, s_context) == EGL_FALSE,
+            false,
+            "EGL context activation failed"
+        );
+    }
+
+    return true;
+}
+
+bool create_framebuffer(unsigned int framebuffer_width, unsigned int framebuffer_height)
+{
+    glGenRenderbuffers(1, &s_color_renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, s_color_renderbuffer);
+    glRenderbufferStorage(
+        GL_RENDERBUFFER,
+        GL_SRGB8_ALPHA8,
+        static_cast<GLsizei>(framebuffer_width),
+        static_cast<GLsizei>(framebuffer_height)
+    );
+
+    glGenRenderbuffers(1, &s_depth_renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, s_depth_renderbuffer);
+    glRenderbufferStorage(
+        GL_RENDERBUFFER,
+        GL_DEPTH_COMPONENT24,
+        static_cast<GLsizei>(framebuffer_width),
+        static_cast<GLsizei>(framebuffer_height)
+    );
+
+    glGenFramebuffers(1, &s_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, s_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, s_color_renderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, s_depth_renderbuffer);
+
+    GLenum status{glCheckFramebufferStatus(GL_FRAMEBUFFER)};
+    VBAIL_ERROR_IF(status != GL_FRAMEBUFFER_COMPLETE, false, "offscreen framebuffer incomplete: {:#x}", status);
+
+    return true;
+}
+} // namespace
+
+bool create_headless_context(unsigned int framebuffer_width, unsigned int framebuffer_height)
+{
+    if (create_context(framebuffer_width, framebuffer_height) == false)
+    {
+        destroy_headless_context();
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+    {
+        Core::log_error("OpenGL loading failed");
+        destroy_headless_context();
+        return false;
+    }
+    Core::log_info("loaded OpenGL {}.{} (headless)", GLVersion.major, GLVersion.minor);
+
+    if (create_framebuffer(framebuffer_width, framebuffer_height) == false)
+    {
+        destroy_headless_context();
+        return false;
+    }
+
+    return true;
+}
+
+void destroy_headless_context()
+{
+    if (s_display == EGL_NO_DISPLAY)
+        return;
+
+    if (s_framebuffer != 0)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &s_framebuffer);
+        glDeleteRenderbuffers(1, &s_color_renderbuffer);
+        glDeleteRenderbuffers(1, &s_depth_renderbuffer);
+        s_framebuffer = 0;
+        s_color_renderbuffer = 0;
+        s_depth_renderbuffer = 0;
+    }
+
+    eglMakeCurrent(s_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (s_context != EGL_NO_CONTEXT)
+        eglDestroyContext(s_display, s_context);
+    if (s_surface != EGL_NO_SURFACE)
+        eglDestroySurface(s_display, s_surface);
+    eglTerminate(s_display);
+
+    s_display = EGL_NO_DISPLAY;
+    s_surface = EGL_NO_SURFACE;
+    s_context = EGL_NO_CONTEXT;
+}
+
+void finish_headless_frame()
+{
+    glFinish();
+}
+#else
+bool create_headless_context(unsigned int, unsigned int)
+{
+    Core::log_error("headless rendering requires a build defining AGE_HEADLESS_EGL");
+    return false;
+}
+
+void destroy_headless_context()
+{
+}
+
+void finish_headless_frame()
+{
+}
+#endif
+} // namespace Age::Gfx
@@ -6,6 +6,7 @@ namespace Age::Input
 {
 namespace
 {
+// Null in headless runs, where no key or button is ever pressed
 GLFWwindow *s_window{};
 
 double s_prev_cursor_position_x{};
@@ -28,17 +29,17 @@ Math::Vector2 s_scroll_delta{};
 
 bool is_key_up(int key)
 {
-    return glfwGetKey(s_window, key) == GLFW_RELEASE;
+    return s_window == nullptr || glfwGetKey(s_window, key) == GLFW_RELEASE;
 }
 
 bool is_key_down(int key)
 {
-    return glfwGetKey(s_window, key) == GLFW_PRESS;
+    return s_window != nullptr && glfwGetKey(s_window, key) == GLFW_PRESS;
 }
 
 bool is_key_pressed(int key, PressedKeys &pressed_keys)
 {
-    bool is_key_pressed{glfwGetKey(s_window, key) == GLFW_PRESS};
+    bool is_key_pressed{is_key_down(key)};
     auto was_key_pressed{pressed_keys[key]};
     if (is_key_pressed && was_key_pressed)
         return false;
@@ -59,22 +60,24 @@ Math::Vector2 get_scroll_delta(const MouseInput &mouse_input)
 
 bool is_mouse_button_up(int button)
 {
-    return glfwGetMouseButton(s_window, button) == GLFW_RELEASE;
+    return s_window == nullptr || glfwGetMouseButton(s_window, button) == GLFW_RELEASE;
 }
 
 bool is_mouse_button_down(int button)
 {
-    return glfwGetMouseButton(s_window, button) == GLFW_PRESS;
+    return s_window != nullptr && glfwGetMouseButton(s_window, button) == GLFW_PRESS;
 }
 
 bool is_exit_requested()
 {
-    return glfwWindowShouldClose(s_window);
+    return s_window != nullptr && glfwWindowShouldClose(s_window);
 }
 
 void init_input_system(GLFWwindow *window)
 {
     s_window = window;
+    if (s_window == nullptr)
+        return;
 
     // TODO: control input settings through a window component
     // glfwSetInputMode(s_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -85,6 +88,9 @@ void init_input_system(GLFWwindow *window)
 
 void init_input_state()
 {
+    if (s_window == nullptr)
+        return;
+
     glfwGetCursorPos(s_window, &s_cursor_position_x, &s_cursor_position_y);
     s_prev_cursor_position_x = s_cursor_position_x;
     s_prev_cursor_position_y = s_cursor_position_y;
@@ -92,7 +98,8 @@ void init_input_state()
 
 void update_input_state()
 {
-    glfwGetCursorPos(s_window, &s_cursor_position_x, &s_cursor_position_y);
+    if (s_window != nullptr)
+        glfwGetCursorPos(s_window, &s_cursor_position_x, &s_cursor_position_y);
     s_cursor_position_delta.x = static_cast<float>(s_cursor_position_x - s_prev_cursor_position_x);
     s_cursor_position_delta.y = static_cast<float>(s_cursor_position_y - s_prev_cursor_position_y);
     s_prev_cursor_position_x = s_cursor_position_x;
@@ -51,6 +51,8 @@ void update_light_group_buffer(const Math::Matrix4 &wv_matrix, const LightGroup
         case Core::ComponentType::POINT_LIGHT:
             calc_point_light(light_id, wv_matrix, light_block.lights[index]);
             break;
+        default:
+            break;
         }
     }
 
@@ -1,10 +1,17 @@
+#include <chrono>
+
 #include "MainLoop.hpp"
 #include "DefaultMeshes.hpp"
 #include "ECS.hpp"
+#include "ECSStats.hpp"
 #include "ErrorHandling.hpp"
 #include "GLFW.hpp"
+#include "Headless.hpp"
 #include "Input.hpp"
 #include "Logging.hpp"
+#include "Profiling.hpp"
+#include "RecordingOpenGL.hpp"
+#include "RenderStats.hpp"
 #include "Rendering.hpp"
 #include "Time.hpp"
 
@@ -18,6 +25,96 @@ void error_callback(int error, const char *description)
 {
     Core::log_error("{}", std::string_view{description});
 }
+
+void run_main_loop(const App::Definitions &definitions, const App::IScene &scene)
+{
+#ifdef AGE_PROFILING
+    Core::init_profiling(definitions);
+#endif
+    Gfx::init_render_stats(definitions);
+
+    Gfx::set_mesh_optimization(definitions.optimize_meshes);
+    Gfx::load_primitive_meshes();
+    scene.init();
+
+    if (definitions.headless == false)
+        glfwPollEvents();
+
+    Input::init_input_state();
+    Time::init_frame_time(definitions.fixed_delta_time);
+
+    auto start_time{std::chrono::steady_clock::now()};
+    std::uint32_t frame_index{};
+    while (Input::is_exit_requested() == false && s_is_exit_requested == false)
+    {
+        if (definitions.frame_count != 0 && frame_index == definitions.frame_count)
+            break;
+        ++frame_index;
+
+        AGE_PROFILE_SCOPE("frame");
+#ifdef AGE_RECORDING_OGL
+        // The log holds the calls of the last frame
+        Gfx::OGL::clear_recorded_calls();
+#endif
+        Time::update_frame_time();
+
+        {
+            AGE_PROFILE_SCOPE("scene_update");
+            scene.update();
+        }
+
+        Gfx::render();
+
+        Core::update_ecs_stats();
+
+        if (definitions.headless)
+        {
+            AGE_PROFILE_SCOPE("finish_headless_frame");
+            Gfx::finish_headless_frame();
+        }
+        else
+            glfwPollEvents();
+
+        Input::update_input_state();
+        Gfx::update_render_state();
+#ifdef AGE_PROFILING
+        Core::update_profiling();
+#endif
+    }
+
+    if (definitions.frame_count != 0 && frame_index != 0)
+    {
+        std::chrono::duration<double, std::milli> total_time{std::chrono::steady_clock::now() - start_time};
+        Core::log_info(
+            "rendered {} frames in {:.3f} ms, {:.3f} ms per frame",
+            frame_index,
+            total_time.count(),
+            total_time.count() / frame_index
+        );
+    }
+
+#ifdef AGE_RECORDING_OGL
+    Gfx::OGL::log_recorded_function_stats();
+#endif
+}
+
+void run_headless_engine(const App::Definitions &definitions, const App::IScene &scene)
+{
+    if (Gfx::create_headless_context(
+            definitions.headless_framebuffer_width, definitions.headless_framebuffer_height
+        ) == false)
+        BAIL_ERROR("headless context creation failed");
+
+    Core::init_ecs(definitions);
+    Input::init_input_system(nullptr);
+    Gfx::init_headless_rendering_system(
+        definitions.headless_framebuffer_width, definitions.headless_framebuffer_height
+    );
+
+    run_main_loop(definitions, scene);
+
+    Gfx::destroy_headless_context();
+}
 } // namespace
 
 void exit()
@@ -29,6 +126,18 @@ void run_engine(const App::Definitions &definitions, const App::IScene &scene)
 {
     Core::init_logging();
 
+#ifdef AGE_RECORDING_OGL
+    // Recording builds have no OpenGL context to present with, so they never open a window nor need a display
+    App::Definitions headless_definitions{definitions};
+    headless_definitions.headless = true;
+    run_headless_engine(headless_definitions, scene);
+#else
+    if (definitions.headless)
+    {
+        run_headless_engine(definitions, scene);
+        return;
+    }
+
     GLFW::Initializer glfw_initializer{};
     if (glfw_initializer == false)
         return;
@@ -53,27 +162,9 @@ void run_engine(const App::Definitions &definitions, const App::IScene &scene)
     Input::init_input_system(window);
     Gfx::init_rendering_system(window);
 
-    Gfx::load_primitive_meshes();
-    scene.init();
-
-    glfwPollEvents();
-
-    Input::init_input_state();
-    Time::init_frame_time();
-    while (Input::is_exit_requested() == false && s_is_exit_requested == false)
-    {
-        Time::update_frame_time();
-
-        scene.update();
-
-        Gfx::render();
-
-        glfwPollEvents();
-
-        Input::update_input_state();
-        Gfx::update_render_state();
-    }
+    run_main_loop(definitions, scene);
 
     glfwDestroyWindow(window);
+#endif
 }
 } // namespace Age::Core
@@ -1,6 +1,7 @@
 #include <limits>
 
 #include "Material.hpp"
+#include "RenderStats.hpp"
 
 namespace Age::Gfx
 {
@@ -37,6 +38,7 @@ const Material &use_material(MaterialId material_id)
         use_shader(material.shader);
         material.apply_properties();
         s_used_material_id = material_id;
+        ++g_render_stats.material_switch_count;
     }
 
     return material;
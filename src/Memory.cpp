@@ -0,0 +1,75 @@
+#include <cstdint>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "ErrorHandling.hpp"
+#include "Memory.hpp"
+
+namespace Age::Memory
+{
+#if defined(_WIN32)
+void *allocate_pages(std::size_t size, bool use_huge_pages)
+{
+    // Large pages require the SeLockMemoryPrivilege, silently fall back to regular pages without it
+    if (use_huge_pages)
+    {
+        SIZE_T large_page_size{GetLargePageMinimum()};
+        if (large_page_size != 0 && size % large_page_size == 0)
+        {
+            void *pages{VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)};
+            if (pages != nullptr)
+                return pages;
+        }
+    }
+
+    void *pages{VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)};
+    VBAIL_ERROR_IF(pages == nullptr, nullptr, "Page allocation of {} bytes failed", size);
+    return pages;
+}
+
+void free_pages(void *pages, std::size_t)
+{
+    VirtualFree(pages, 0, MEM_RELEASE);
+}
+#else
+void *allocate_pages(std::size_t size, bool use_huge_pages)
+{
+    // Transparent huge pages are only used for huge page aligned ranges,
+    // so over-allocate and trim the unaligned head and tail
+    std::size_t mapped_size{use_huge_pages ? size + HUGE_PAGE_SIZE : size};
+
+    void *mapping{mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    VBAIL_ERROR_IF(mapping == MAP_FAILED, nullptr, "Page allocation of {} bytes failed", size);
+
+    if (use_huge_pages == false)
+        return mapping;
+
+    auto mapping_address = reinterpret_cast<std::uintptr_t>(mapping);
+    std::size_t head_size{padding_to<HUGE_PAGE_SIZE>(mapping_address)};
+    std::size_t tail_size{HUGE_PAGE_SIZE - head_size};
+
+    auto *pages = static_cast<std::byte *>(mapping) + head_size;
+    if (head_size != 0)
+        munmap(mapping, head_size);
+    if (tail_size != 0)
+        munmap(pages + size, tail_size);
+
+#if defined(MADV_HUGEPAGE)
+    madvise(pages, size, MADV_HUGEPAGE);
+#endif
+
+    return pages;
+}
+
+void free_pages(void *pages, std::size_t size)
+{
+    munmap(pages, size);
+}
+#endif
+} // namespace Age::Memory
@@ -1,155 +1,586 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "Logging.hpp"
 #include "Mesh.hpp"
+#include "MeshOptimization.hpp"
+#include "VertexEncoding.hpp"
 
 namespace Age::Gfx
 {
-static std::vector<MeshBuffers> s_mesh_buffers{};
-std::vector<DrawCommand> g_draw_commands{};
-std::vector<Mesh> g_meshes{};
+namespace
+{
+// Attributes present besides the positions, the vertices of an arena are interleaved in this order
+constexpr std::uint8_t WITH_VERTEX_COLORS{0b1};
+constexpr std::uint8_t WITH_VERTEX_NORMALS{0b10};
+constexpr std::uint8_t WITH_VERTEX_TEXTURE_COORDS{0b100};
+// The vertex compression options are stored above the attribute bits
+constexpr unsigned int VERTEX_COMPRESSION_SHIFT{3};
+constexpr std::size_t VERTEX_FORMAT_COUNT{1 << 7};
 
-void init_mesh_system()
+constexpr std::size_t MESH_ARENA_VERTEX_BUFFER_SIZE{4 * 1024 * 1024};
+constexpr std::size_t MESH_ARENA_INDEX_BUFFER_SIZE{1024 * 1024};
+constexpr std::size_t MAX_SHORT_INDEXED_VERTEX_COUNT{std::size_t{std::numeric_limits<std::uint16_t>::max()} + 1};
+
+struct VertexAttribute
 {
-    s_mesh_buffers.reserve(128);
-    g_draw_commands.reserve(256);
-    g_meshes.reserve(128);
-}
+    GLuint index{};
+    GLint component_count{};
+    GLenum type{};
+    bool is_normalized{};
+    std::uint32_t offset{};
+};
 
-void create_arrays_mesh(
-    const Math::Vector3 *vertex_positions,
+// Every attribute starts on 4 bytes, so 3 component half floats and bytes are padded
+struct VertexLayout
+{
+    VertexAttribute attributes[4]{};
+    std::uint32_t attribute_count{};
+    std::uint32_t vertex_size{};
+
+    void add_attribute(GLuint index, GLint component_count, GLenum type, bool is_normalized, std::uint32_t size)
+    {
+        attributes[attribute_count++] = {index, component_count, type, is_normalized, vertex_size};
+        vertex_size += size;
+    }
+};
+
+// Vertex and index buffers shared by the meshes of a vertex format, through a single vertex array.
+// Meshes are appended until the buffers are full, then a new arena is created.
+struct MeshArena
+{
+    GLuint vertex_array_object{};
+    GLuint vertex_buffer_object{};
+    GLuint index_buffer_object{};
+    std::size_t vertex_buffer_size{};
+    std::size_t index_buffer_size{};
+    std::size_t used_vertex_buffer_size{};
+    std::size_t used_index_buffer_size{};
+};
+
+// Reordered copies of the data of an optimized mesh
+struct OptimizedMeshData
+{
+    std::vector<Math::Vector3> vertex_positions{};
+    std::vector<Math::Vector3> vertex_colors{};
+    std::vector<Math::Vector3> vertex_normals{};
+    std::vector<Math::Vector2> vertex_texture_coords{};
+    std::vector<std::uint32_t> vertex_indices{};
+    std::vector<unsigned short> short_vertex_indices{};
+};
+
+std::vector<MeshBuffers> s_mesh_buffers{};
+std::vector<MeshArena> s_mesh_arenas[VERTEX_FORMAT_COUNT]{};
+bool s_is_mesh_optimization_enabled{};
+
+// The compression options of missing attributes are dropped, so they do not split the arenas
+std::uint8_t get_vertex_format(
     const Math::Vector3 *vertex_colors,
     const Math::Vector3 *vertex_normals,
     const Math::Vector2 *vertex_texture_coords,
-    std::size_t vertex_count,
-    OGL::RenderingMode rendering_mode,
-    MeshBuffers &mesh_buffers,
-    DrawCommand &draw_command
+    unsigned int vertex_compression
 )
 {
-    glGenVertexArrays(1, &mesh_buffers.vertex_array_object);
-    glBindVertexArray(mesh_buffers.vertex_array_object);
-
-    std::size_t buffer_size{vertex_count * sizeof(*vertex_positions)};
+    std::uint8_t vertex_format{};
+    unsigned int used_vertex_compression{vertex_compression & HALF_FLOAT_POSITIONS};
     if (vertex_colors != nullptr)
-        buffer_size += vertex_count * sizeof(*vertex_colors);
+    {
+        vertex_format |= WITH_VERTEX_COLORS;
+        used_vertex_compression |= vertex_compression & BYTE_COLORS;
+    }
     if (vertex_normals != nullptr)
-        buffer_size += vertex_count * sizeof(*vertex_normals);
+    {
+        vertex_format |= WITH_VERTEX_NORMALS;
+        used_vertex_compression |= vertex_compression & PACKED_NORMALS;
+    }
     if (vertex_texture_coords != nullptr)
-        buffer_size += vertex_count * sizeof(*vertex_texture_coords);
+    {
+        vertex_format |= WITH_VERTEX_TEXTURE_COORDS;
+        used_vertex_compression |= vertex_compression & HALF_FLOAT_TEXTURE_COORDS;
+    }
+    return static_cast<std::uint8_t>(vertex_format | used_vertex_compression << VERTEX_COMPRESSION_SHIFT);
+}
 
-    glGenBuffers(1, &mesh_buffers.vertex_buffer_object);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffers.vertex_buffer_object);
-    glBufferData(GL_ARRAY_BUFFER, buffer_size, nullptr, GL_STATIC_DRAW);
+VertexLayout get_vertex_layout(std::uint8_t vertex_format)
+{
+    unsigned int vertex_compression{static_cast<unsigned int>(vertex_format >> VERTEX_COMPRESSION_SHIFT)};
 
-    std::size_t buffer_offset{0};
+    VertexLayout layout{};
+    if (vertex_compression & HALF_FLOAT_POSITIONS)
+        layout.add_attribute(0, 3, GL_HALF_FLOAT, false, 8);
+    else
+        layout.add_attribute(0, 3, GL_FLOAT, false, 12);
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-    glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(*vertex_positions), vertex_positions);
-    buffer_offset += vertex_count * sizeof(*vertex_positions);
+    if (vertex_format & WITH_VERTEX_COLORS)
+    {
+        if (vertex_compression & BYTE_COLORS)
+            layout.add_attribute(1, 3, GL_UNSIGNED_BYTE, true, 4);
+        else
+            layout.add_attribute(1, 3, GL_FLOAT, false, 12);
+    }
 
-    if (vertex_colors != nullptr)
+    if (vertex_format & WITH_VERTEX_NORMALS)
     {
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(*vertex_colors), vertex_colors);
-        buffer_offset += vertex_count * sizeof(*vertex_colors);
+        if (vertex_compression & PACKED_NORMALS)
+            layout.add_attribute(2, 4, GL_INT_2_10_10_10_REV, true, 4);
+        else
+            layout.add_attribute(2, 3, GL_FLOAT, false, 12);
     }
-    if (vertex_normals != nullptr)
+
+    if (vertex_format & WITH_VERTEX_TEXTURE_COORDS)
     {
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(*vertex_normals), vertex_normals);
-        buffer_offset += vertex_count * sizeof(*vertex_normals);
+        if (vertex_compression & HALF_FLOAT_TEXTURE_COORDS)
+            layout.add_attribute(3, 2, GL_HALF_FLOAT, false, 4);
+        else
+            layout.add_attribute(3, 2, GL_FLOAT, false, 8);
     }
-    if (vertex_texture_coords != nullptr)
+
+    return layout;
+}
+
+MeshArena &create_mesh_arena(
+    std::uint8_t vertex_format,
+    const VertexLayout &layout,
+    std::size_t vertex_buffer_size,
+    std::size_t index_buffer_size
+)
+{
+    MeshArena &arena{s_mesh_arenas[vertex_format].emplace_back()};
+    arena.vertex_buffer_size = std::max(vertex_buffer_size, MESH_ARENA_VERTEX_BUFFER_SIZE);
+    arena.index_buffer_size = std::max(index_buffer_size, MESH_ARENA_INDEX_BUFFER_SIZE);
+
+    glGenVertexArrays(1, &arena.vertex_array_object);
+    OGL::bind_vertex_array_object(arena.vertex_array_object);
+
+    glGenBuffers(1, &arena.vertex_buffer_object);
+    OGL::bind_array_buffer(arena.vertex_buffer_object);
+    glBufferData(GL_ARRAY_BUFFER, arena.vertex_buffer_size, nullptr, GL_STATIC_DRAW);
+
+    for (std::uint32_t index{}; index < layout.attribute_count; ++index)
     {
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 2, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(
-            GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(*vertex_texture_coords), vertex_texture_coords
+        const VertexAttribute &attribute{layout.attributes[index]};
+        glEnableVertexAttribArray(attribute.index);
+        glVertexAttribPointer(
+            attribute.index,
+            attribute.component_count,
+            attribute.type,
+            attribute.is_normalized,
+            static_cast<GLsizei>(layout.vertex_size),
+            reinterpret_cast<GLvoid *>(static_cast<std::size_t>(attribute.offset))
         );
-        buffer_offset += vertex_count * sizeof(*vertex_texture_coords);
     }
 
-    glBindVertexArray(0);
+    glGenBuffers(1, &arena.index_buffer_object);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.index_buffer_object);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, arena.index_buffer_size, nullptr, GL_STATIC_DRAW);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // The index buffer binding is part of the vertex array state
+    OGL::bind_vertex_array_object(0);
+    OGL::bind_array_buffer(0);
 
-    draw_command.type = DrawCommandType::DRAW_ARRAYS;
-    draw_command.rendering_mode = rendering_mode;
-    draw_command.element_count = static_cast<std::uint32_t>(vertex_count);
-    draw_command.offset = 0;
+    return arena;
 }
 
-void create_elements_mesh(
+void encode_vertex_attribute(std::byte *vertex, const VertexAttribute &attribute, const float *components)
+{
+    std::byte *encoded_attribute{vertex + attribute.offset};
+    switch (attribute.type)
+    {
+    case GL_HALF_FLOAT:
+        for (GLint index{}; index < attribute.component_count; ++index)
+        {
+            std::uint16_t encoded_component{encode_half_float(components[index])};
+            std::memcpy(encoded_attribute + index * sizeof(std::uint16_t), &encoded_component, sizeof(std::uint16_t));
+        }
+        break;
+    case GL_UNSIGNED_BYTE: {
+        std::uint32_t encoded_color{encode_byte_color({components[0], components[1], components[2]})};
+        std::memcpy(encoded_attribute, &encoded_color, sizeof(std::uint32_t));
+        break;
+    }
+    case GL_INT_2_10_10_10_REV: {
+        std::uint32_t encoded_normal{encode_packed_normal({components[0], components[1], components[2]})};
+        std::memcpy(encoded_attribute, &encoded_normal, sizeof(std::uint32_t));
+        break;
+    }
+    default:
+        std::memcpy(encoded_attribute, components, attribute.component_count * sizeof(float));
+        break;
+    }
+}
+
+// The float attributes are converted to the encodings of the layout and interleaved
+std::vector<std::byte> encode_vertices(
+    const VertexLayout &layout,
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count
+)
+{
+    std::vector<std::byte> vertices(vertex_count * layout.vertex_size);
+    for (std::size_t index{}; index < vertex_count; ++index)
+    {
+        std::byte *vertex{&vertices[index * layout.vertex_size]};
+        const VertexAttribute *attribute{layout.attributes};
+        encode_vertex_attribute(vertex, *attribute++, static_cast<const float *>(vertex_positions[index]));
+        if (vertex_colors != nullptr)
+            encode_vertex_attribute(vertex, *attribute++, static_cast<const float *>(vertex_colors[index]));
+        if (vertex_normals != nullptr)
+            encode_vertex_attribute(vertex, *attribute++, static_cast<const float *>(vertex_normals[index]));
+        if (vertex_texture_coords != nullptr)
+            encode_vertex_attribute(vertex, *attribute++, static_cast<const float *>(vertex_texture_coords[index]));
+    }
+    return vertices;
+}
+
+// The mesh vertices start at the base vertex of the arena and its indices at the index offset, in bytes.
+// 16 and 32 bit indices share the index buffers, the index offset is aligned on the index size.
+void create_arena_mesh(
     const Math::Vector3 *vertex_positions,
     const Math::Vector3 *vertex_colors,
     const Math::Vector3 *vertex_normals,
     const Math::Vector2 *vertex_texture_coords,
     std::size_t vertex_count,
-    const unsigned short *vertex_indices,
+    const void *vertex_indices,
     std::size_t vertex_index_count,
-    OGL::RenderingMode rendering_mode,
+    OGL::IndexType index_type,
+    unsigned int vertex_compression,
     MeshBuffers &mesh_buffers,
-    DrawCommand &draw_command
+    std::int32_t &base_vertex,
+    std::size_t &index_offset
 )
 {
-    glGenVertexArrays(1, &mesh_buffers.vertex_array_object);
-    glBindVertexArray(mesh_buffers.vertex_array_object);
+    std::uint8_t vertex_format{
+        get_vertex_format(vertex_colors, vertex_normals, vertex_texture_coords, vertex_compression)
+    };
+    VertexLayout layout{get_vertex_layout(vertex_format)};
+    std::size_t vertex_buffer_size{vertex_count * layout.vertex_size};
+    std::size_t index_size{OGL::get_index_size(index_type)};
+    std::size_t index_buffer_size{vertex_index_count * index_size};
 
-    std::size_t buffer_size{vertex_count * sizeof(Math::Vector3)};
-    if (vertex_colors != nullptr)
-        buffer_size += vertex_count * sizeof(Math::Vector3);
-    if (vertex_normals != nullptr)
-        buffer_size += vertex_count * sizeof(Math::Vector3);
-    if (vertex_texture_coords != nullptr)
-        buffer_size += vertex_count * sizeof(Math::Vector2);
+    std::vector<MeshArena> &arenas{s_mesh_arenas[vertex_format]};
+    auto get_aligned_index_offset = [&](const MeshArena &arena) {
+        return (arena.used_index_buffer_size + index_size - 1) / index_size * index_size;
+    };
+    if (arenas.empty() ||
+        arenas.back().used_vertex_buffer_size + vertex_buffer_size > arenas.back().vertex_buffer_size ||
+        get_aligned_index_offset(arenas.back()) + index_buffer_size > arenas.back().index_buffer_size)
+        create_mesh_arena(vertex_format, layout, vertex_buffer_size, index_buffer_size);
+    MeshArena &arena{arenas.back()};
+    arena.used_index_buffer_size = get_aligned_index_offset(arena);
 
-    glGenBuffers(1, &mesh_buffers.vertex_buffer_object);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffers.vertex_buffer_object);
-    glBufferData(GL_ARRAY_BUFFER, buffer_size, nullptr, GL_STATIC_DRAW);
+    std::vector<std::byte> vertices{
+        encode_vertices(layout, vertex_positions, vertex_colors, vertex_normals, vertex_texture_coords, vertex_count)
+    };
+    OGL::write_array_buffer(
+        arena.vertex_buffer_object, arena.used_vertex_buffer_size, vertices.data(), vertex_buffer_size
+    );
+    OGL::bind_array_buffer(0);
 
-    std::size_t buffer_offset{0};
+    if (vertex_index_count != 0)
+    {
+        OGL::bind_vertex_array_object(arena.vertex_array_object);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, arena.used_index_buffer_size, index_buffer_size, vertex_indices);
+        OGL::bind_vertex_array_object(0);
+    }
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-    glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(Math::Vector3), vertex_positions);
-    buffer_offset += vertex_count * sizeof(Math::Vector3);
+    base_vertex = static_cast<std::int32_t>(arena.used_vertex_buffer_size / layout.vertex_size);
+    index_offset = arena.used_index_buffer_size;
+    arena.used_vertex_buffer_size += vertex_buffer_size;
+    arena.used_index_buffer_size += index_buffer_size;
 
-    if (vertex_colors != nullptr)
+    mesh_buffers.vertex_array_object = arena.vertex_array_object;
+    mesh_buffers.vertex_buffer_object = arena.vertex_buffer_object;
+    mesh_buffers.index_buffer_object = arena.index_buffer_object;
+    mesh_buffers.bounds = compute_mesh_bounds(vertex_positions, vertex_count);
+}
+template <typename TVertex>
+const TVertex *reorder_mesh_vertices(
+    const TVertex *vertices, std::span<const std::uint32_t> vertex_order, std::vector<TVertex> &reordered_vertices
+)
+{
+    if (vertices == nullptr)
+        return nullptr;
+
+    reordered_vertices = reorder_vertices(vertices, vertex_order);
+    return reordered_vertices.data();
+}
+
+// The mesh data pointers are replaced by the optimized copies
+void optimize_mesh_data(
+    OptimizedMeshData &optimized_mesh_data,
+    const Math::Vector3 *&vertex_positions,
+    const Math::Vector3 *&vertex_colors,
+    const Math::Vector3 *&vertex_normals,
+    const Math::Vector2 *&vertex_texture_coords,
+    std::size_t vertex_count,
+    const void *&vertex_indices,
+    std::size_t vertex_index_count,
+    OGL::IndexType index_type
+)
+{
+    std::vector<std::uint32_t> &optimized_vertex_indices{optimized_mesh_data.vertex_indices};
+    if (index_type == OGL::IndexType::UNSIGNED_INT)
     {
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(Math::Vector3), vertex_colors);
-        buffer_offset += vertex_count * sizeof(Math::Vector3);
+        auto indices{static_cast<const std::uint32_t *>(vertex_indices)};
+        optimized_vertex_indices.assign(indices, indices + vertex_index_count);
     }
-    if (vertex_normals != nullptr)
+    else
     {
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(Math::Vector3), vertex_normals);
-        buffer_offset += vertex_count * sizeof(Math::Vector3);
+        auto indices{static_cast<const unsigned short *>(vertex_indices)};
+        optimized_vertex_indices.assign(indices, indices + vertex_index_count);
     }
-    if (vertex_texture_coords != nullptr)
+
+    MeshOptimizationResult result{optimize_mesh(optimized_vertex_indices, vertex_positions, vertex_count)};
+    Core::log_info(
+        "optimized mesh of {} triangles, ACMR {:.3f} -> {:.3f}",
+        vertex_index_count / 3,
+        result.acmr_before,
+        result.acmr_after
+    );
+
+    vertex_positions =
+        reorder_mesh_vertices(vertex_positions, result.vertex_order, optimized_mesh_data.vertex_positions);
+    vertex_colors = reorder_mesh_vertices(vertex_colors, result.vertex_order, optimized_mesh_data.vertex_colors);
+    vertex_normals = reorder_mesh_vertices(vertex_normals, result.vertex_order, optimized_mesh_data.vertex_normals);
+    vertex_texture_coords = reorder_mesh_vertices(
+        vertex_texture_coords, result.vertex_order, optimized_mesh_data.vertex_texture_coords
+    );
+
+    if (index_type == OGL::IndexType::UNSIGNED_INT)
+        vertex_indices = optimized_vertex_indices.data();
+    else
     {
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 2, GL_FLOAT, false, 0, reinterpret_cast<GLvoid *>(buffer_offset));
-        glBufferSubData(GL_ARRAY_BUFFER, buffer_offset, vertex_count * sizeof(Math::Vector2), vertex_texture_coords);
-        buffer_offset += vertex_count * sizeof(Math::Vector2);
+        optimized_mesh_data.short_vertex_indices.assign(
+            optimized_vertex_indices.begin(), optimized_vertex_indices.end()
+        );
+        vertex_indices = optimized_mesh_data.short_vertex_indices.data();
     }
+}
 
-    glGenBuffers(1, &mesh_buffers.index_buffer_object);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh_buffers.index_buffer_object);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, vertex_index_count * sizeof(unsigned short), vertex_indices, GL_STATIC_DRAW);
-
-    glBindVertexArray(0);
+void create_indexed_mesh(
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count,
+    const void *vertex_indices,
+    std::size_t vertex_index_count,
+    OGL::IndexType index_type,
+    OGL::RenderingMode rendering_mode,
+    unsigned int vertex_compression,
+    MeshBuffers &mesh_buffers,
+    DrawCommand &draw_command
+)
+{
+    // Strips and fans depend on the order of their indices
+    OptimizedMeshData optimized_mesh_data{};
+    if (s_is_mesh_optimization_enabled && rendering_mode == OGL::RenderingMode::TRIANGLES)
+    {
+        optimize_mesh_data(
+            optimized_mesh_data,
+            vertex_positions,
+            vertex_colors,
+            vertex_normals,
+            vertex_texture_coords,
+            vertex_count,
+            vertex_indices,
+            vertex_index_count,
+            index_type
+        );
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    std::int32_t base_vertex{};
+    std::size_t index_offset{};
+    create_arena_mesh(
+        vertex_positions,
+        vertex_colors,
+        vertex_normals,
+        vertex_texture_coords,
+        vertex_count,
+        vertex_indices,
+        vertex_index_count,
+        index_type,
+        vertex_compression,
+        mesh_buffers,
+        base_vertex,
+        index_offset
+    );
 
     draw_command.type = DrawCommandType::DRAW_ELEMENTS;
     draw_command.rendering_mode = rendering_mode;
     draw_command.element_count = static_cast<std::uint32_t>(vertex_index_count);
-    draw_command.offset = 0;
+    draw_command.offset = index_offset;
+    draw_command.base_vertex = base_vertex;
+    draw_command.index_type = index_type;
+}
+} // namespace
+
+std::vector<DrawCommand> g_draw_commands{};
+std::vector<Mesh> g_meshes{};
+
+void init_mesh_system()
+{
+    s_mesh_buffers.reserve(128);
+    g_draw_commands.reserve(256);
+    g_meshes.reserve(128);
+}
+
+void set_mesh_optimization(bool is_enabled)
+{
+    s_is_mesh_optimization_enabled = is_enabled;
+}
+
+MeshBounds compute_mesh_bounds(const Math::Vector3 *vertex_positions, std::size_t vertex_count)
+{
+    if (vertex_count == 0)
+        return {};
+
+    MeshBounds bounds{.aabb_min = vertex_positions[0], .aabb_max = vertex_positions[0]};
+    for (std::size_t index{1}; index < vertex_count; ++index)
+    {
+        const Math::Vector3 &position{vertex_positions[index]};
+        bounds.aabb_min = {
+            std::min(bounds.aabb_min.x, position.x),
+            std::min(bounds.aabb_min.y, position.y),
+            std::min(bounds.aabb_min.z, position.z)
+        };
+        bounds.aabb_max = {
+            std::max(bounds.aabb_max.x, position.x),
+            std::max(bounds.aabb_max.y, position.y),
+            std::max(bounds.aabb_max.z, position.z)
+        };
+    }
+
+    bounds.center = (bounds.aabb_min + bounds.aabb_max) * 0.5f;
+    float squared_radius{};
+    for (std::size_t index{}; index < vertex_count; ++index)
+    {
+        Math::Vector3 offset{vertex_positions[index] - bounds.center};
+        squared_radius = std::max(squared_radius, Math::dot(offset, offset));
+    }
+    bounds.radius = std::sqrt(squared_radius);
+    return bounds;
+}
+
+void create_arrays_mesh(
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count,
+    OGL::RenderingMode rendering_mode,
+    MeshBuffers &mesh_buffers,
+    DrawCommand &draw_command,
+    unsigned int vertex_compression
+)
+{
+    std::int32_t base_vertex{};
+    std::size_t index_offset{};
+    create_arena_mesh(
+        vertex_positions,
+        vertex_colors,
+        vertex_normals,
+        vertex_texture_coords,
+        vertex_count,
+        nullptr,
+        0,
+        OGL::IndexType::UNSIGNED_SHORT,
+        vertex_compression,
+        mesh_buffers,
+        base_vertex,
+        index_offset
+    );
+
+    draw_command.type = DrawCommandType::DRAW_ARRAYS;
+    draw_command.rendering_mode = rendering_mode;
+    draw_command.element_count = static_cast<std::uint32_t>(vertex_count);
+    draw_command.offset = static_cast<std::size_t>(base_vertex);
+    draw_command.base_vertex = 0;
+    draw_command.index_type = OGL::IndexType::UNSIGNED_SHORT;
+}
+
+void create_elements_mesh(
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count,
+    const unsigned short *vertex_indices,
+    std::size_t vertex_index_count,
+    OGL::RenderingMode rendering_mode,
+    MeshBuffers &mesh_buffers,
+    DrawCommand &draw_command,
+    unsigned int vertex_compression
+)
+{
+    create_indexed_mesh(
+        vertex_positions,
+        vertex_colors,
+        vertex_normals,
+        vertex_texture_coords,
+        vertex_count,
+        vertex_indices,
+        vertex_index_count,
+        OGL::IndexType::UNSIGNED_SHORT,
+        rendering_mode,
+        vertex_compression,
+        mesh_buffers,
+        draw_command
+    );
+}
+
+void create_elements_mesh(
+    const Math::Vector3 *vertex_positions,
+    const Math::Vector3 *vertex_colors,
+    const Math::Vector3 *vertex_normals,
+    const Math::Vector2 *vertex_texture_coords,
+    std::size_t vertex_count,
+    const std::uint32_t *vertex_indices,
+    std::size_t vertex_index_count,
+    OGL::RenderingMode rendering_mode,
+    MeshBuffers &mesh_buffers,
+    DrawCommand &draw_command,
+    unsigned int vertex_compression
+)
+{
+    if (vertex_count > MAX_SHORT_INDEXED_VERTEX_COUNT)
+    {
+        create_indexed_mesh(
+            vertex_positions,
+            vertex_colors,
+            vertex_normals,
+            vertex_texture_coords,
+            vertex_count,
+            vertex_indices,
+            vertex_index_count,
+            OGL::IndexType::UNSIGNED_INT,
+            rendering_mode,
+            vertex_compression,
+            mesh_buffers,
+            draw_command
+        );
+        return;
+    }
+
+    std::vector<unsigned short> short_vertex_indices(vertex_indices, vertex_indices + vertex_index_count);
+    create_elements_mesh(
+        vertex_positions,
+        vertex_colors,
+        vertex_normals,
+        vertex_texture_coords,
+        vertex_count,
+        short_vertex_indices.data(),
+        vertex_index_count,
+        rendering_mode,
+        mesh_buffers,
+        draw_command,
+        vertex_compression
+    );
 }
 
 MeshBuffers &create_mesh_buffers(std::uint16_t &index)
@@ -172,4 +603,9 @@ MeshDrawCommands get_mesh_draw_commands(MeshId mesh_id)
         .draw_commands = {g_draw_commands.begin() + mesh.draw_command_offset, mesh.draw_command_count}
     };
 }
+
+const MeshBounds &get_mesh_bounds(MeshId mesh_id)
+{
+    return g_meshes[mesh_id].bounds;
+}
 } // namespace Age::Gfx
@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "MeshOptimization.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+constexpr std::uint32_t NO_TRIANGLE{std::numeric_limits<std::uint32_t>::max()};
+constexpr std::uint32_t UNUSED_VERTEX{std::numeric_limits<std::uint32_t>::max()};
+
+// Scoring constants of Forsyth's article
+constexpr std::uint32_t FORSYTH_CACHE_SIZE{32};
+constexpr float CACHE_DECAY_POWER{1.5f};
+constexpr float LAST_TRIANGLE_SCORE{0.75f};
+constexpr float VALENCE_BOOST_SCALE{2.0f};
+constexpr float VALENCE_BOOST_POWER{0.5f};
+
+// A vertex is in the cache when fewer than cache size misses happened since it was loaded
+class FifoCache
+{
+    std::vector<std::uint32_t> _load_times{};
+    std::uint32_t _time{};
+    std::uint32_t _size{};
+
+  public:
+    FifoCache(std::size_t vertex_count, std::uint32_t size)
+        : _load_times(vertex_count)
+        , _time{size + 1}
+        , _size{size}
+    {
+    }
+
+    // Returns true on a miss
+    bool access(std::uint32_t vertex_index)
+    {
+        if (_time - _load_times[vertex_index] <= _size)
+            return false;
+
+        _load_times[vertex_index] = _time++;
+        return true;
+    }
+
+    void clear()
+    {
+        _time += _size + 1;
+    }
+};
+
+struct TriangleCluster
+{
+    std::size_t first_index{};
+    std::size_t index_count{};
+    float sort_key{};
+};
+
+float get_vertex_score(std::int32_t cache_position, std::uint32_t remaining_triangle_count)
+{
+    if (remaining_triangle_count == 0)
+        return -1.0f;
+
+    float score{};
+    // The vertices of the last triangle get a fixed score, so the next triangle does not reuse all of them
+    if (cache_position >= 0 && cache_position < 3)
+        score = LAST_TRIANGLE_SCORE;
+    else if (cache_position >= 3)
+    {
+        float cache_score{1.0f - static_cast<float>(cache_position - 3) / (FORSYTH_CACHE_SIZE - 3)};
+        score = std::pow(cache_score, CACHE_DECAY_POWER);
+    }
+
+    // Vertices with few triangles left are favored, so no lonely triangle is left behind
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining_triangle_count), -VALENCE_BOOST_POWER);
+}
+
+// Clusters end where the cache restarts, a triangle with three cache misses,
+// and are split further while their ACMR stays within the threshold of the whole cluster
+std::vector<TriangleCluster> split_triangle_clusters(
+    std::span<const std::uint32_t> vertex_indices, std::size_t vertex_count, float acmr_threshold
+)
+{
+    std::size_t triangle_index_count{vertex_indices.size() / 3 * 3};
+
+    std::vector<std::size_t> hard_cluster_starts{};
+    FifoCache cache{vertex_count, ACMR_CACHE_SIZE};
+    for (std::size_t index{}; index < triangle_index_count; index += 3)
+    {
+        bool is_miss_0{cache.access(vertex_indices[index])};
+        bool is_miss_1{cache.access(vertex_indices[index + 1])};
+        bool is_miss_2{cache.access(vertex_indices[index + 2])};
+        if (is_miss_0 && is_miss_1 && is_miss_2)
+            hard_cluster_starts.push_back(index);
+    }
+    hard_cluster_starts.push_back(triangle_index_count);
+
+    std::vector<TriangleCluster> clusters{};
+    for (std::size_t hard_cluster_index{}; hard_cluster_index + 1 < hard_cluster_starts.size(); ++hard_cluster_index)
+    {
+        std::size_t start{hard_cluster_starts[hard_cluster_index]};
+        std::size_t end{hard_cluster_starts[hard_cluster_index + 1]};
+        float max_acmr{compute_acmr(vertex_indices.subspan(start, end - start), vertex_count) * acmr_threshold};
+
+        std::size_t cluster_start{start};
+        std::uint32_t miss_count{};
+        cache.clear();
+        for (std::size_t index{start}; index < end; index += 3)
+        {
+            miss_count += cache.access(vertex_indices[index]);
+            miss_count += cache.access(vertex_indices[index + 1]);
+            miss_count += cache.access(vertex_indices[index + 2]);
+
+            float cluster_acmr{static_cast<float>(miss_count) / static_cast<float>((index + 3 - cluster_start) / 3)};
+            if (index + 3 == end || cluster_acmr <= max_acmr)
+            {
+                clusters.push_back({.first_index = cluster_start, .index_count = index + 3 - cluster_start});
+                cluster_start = index + 3;
+                miss_count = 0;
+                cache.clear();
+            }
+        }
+    }
+    return clusters;
+}
+} // namespace
+
+float compute_acmr(std::span<const std::uint32_t> vertex_indices, std::size_t vertex_count, std::uint32_t cache_size)
+{
+    std::size_t triangle_count{vertex_indices.size() / 3};
+    if (triangle_count == 0)
+        return 0.0f;
+
+    FifoCache cache{vertex_count, cache_size};
+    std::uint32_t miss_count{};
+    for (std::size_t index{}; index < triangle_count * 3; ++index)
+        miss_count += cache.access(vertex_indices[index]);
+    return static_cast<float>(miss_count) / static_cast<float>(triangle_count);
+}
+
+void optimize_vertex_cache(std::span<std::uint32_t> vertex_indices, std::size_t vertex_count)
+{
+    std::size_t triangle_count{vertex_indices.size() / 3};
+    if (triangle_count == 0)
+        return;
+
+    // The triangles of each vertex, the remaining ones first
+    std::vector<std::uint32_t> remaining_triangle_counts(vertex_count);
+    for (std::size_t index{}; index < triangle_count * 3; ++index)
+        ++remaining_triangle_counts[vertex_indices[index]];
+
+    std::vector<std::uint32_t> vertex_triangle_offsets(vertex_count + 1);
+    for (std::size_t index{}; index < vertex_count; ++index)
+        vertex_triangle_offsets[index + 1] = vertex_triangle_offsets[index] + remaining_triangle_counts[index];
+
+    std::vector<std::uint32_t> vertex_triangles(triangle_count * 3);
+    std::vector<std::uint32_t> vertex_triangle_ends{vertex_triangle_offsets.begin(), vertex_triangle_offsets.end() - 1};
+    for (std::size_t index{}; index < triangle_count * 3; ++index)
+        vertex_triangles[vertex_triangle_ends[vertex_indices[index]]++] = static_cast<std::uint32_t>(index / 3);
+
+    std::vector<std::int32_t> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+    for (std::size_t index{}; index < vertex_count; ++index)
+        vertex_scores[index] = get_vertex_score(-1, remaining_triangle_counts[index]);
+
+    std::vector<float> triangle_scores(triangle_count);
+    for (std::size_t index{}; index < triangle_count; ++index)
+    {
+        triangle_scores[index] = vertex_scores[vertex_indices[index * 3]] +
+                                 vertex_scores[vertex_indices[index * 3 + 1]] +
+                                 vertex_scores[vertex_indices[index * 3 + 2]];
+    }
+
+    std::vector<bool> is_triangle_emitted(triangle_count);
+    std::vector<std::uint32_t> optimized_vertex_indices(triangle_count * 3);
+    std::vector<std::uint32_t> cache{};
+    std::vector<std::uint32_t> next_cache{};
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    next_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    auto best_triangle{static_cast<std::uint32_t>(
+        std::max_element(triangle_scores.begin(), triangle_scores.end()) - triangle_scores.begin()
+    )};
+    std::size_t next_unemitted_triangle{};
+    for (std::size_t emitted_triangle_count{}; emitted_triangle_count < triangle_count; ++emitted_triangle_count)
+    {
+        // No triangle left around the cache, the scan restarts from a triangle not emitted yet
+        if (best_triangle == NO_TRIANGLE)
+        {
+            while (is_triangle_emitted[next_unemitted_triangle])
+                ++next_unemitted_triangle;
+            best_triangle = static_cast<std::uint32_t>(next_unemitted_triangle);
+        }
+
+        is_triangle_emitted[best_triangle] = true;
+        next_cache.clear();
+        for (std::size_t corner{}; corner < 3; ++corner)
+        {
+            std::uint32_t vertex_index{vertex_indices[best_triangle * 3 + corner]};
+            optimized_vertex_indices[emitted_triangle_count * 3 + corner] = vertex_index;
+            // Degenerate triangles repeat vertices
+            if (std::find(next_cache.begin(), next_cache.end(), vertex_index) == next_cache.end())
+                next_cache.push_back(vertex_index);
+
+            // The emitted triangle is swapped past the remaining triangles of the vertex
+            std::uint32_t *triangles{&vertex_triangles[vertex_triangle_offsets[vertex_index]]};
+            std::uint32_t &remaining_triangle_count{remaining_triangle_counts[vertex_index]};
+            std::swap(
+                *std::find(triangles, triangles + remaining_triangle_count, best_triangle),
+                triangles[remaining_triangle_count - 1]
+            );
+            --remaining_triangle_count;
+        }
+
+        auto triangle_vertex_count{static_cast<std::ptrdiff_t>(next_cache.size())};
+        for (std::uint32_t vertex_index : cache)
+        {
+            auto triangle_vertices_end{next_cache.begin() + triangle_vertex_count};
+            if (std::find(next_cache.begin(), triangle_vertices_end, vertex_index) == triangle_vertices_end)
+                next_cache.push_back(vertex_index);
+        }
+
+        for (std::size_t cache_position{}; cache_position < next_cache.size(); ++cache_position)
+        {
+            std::uint32_t vertex_index{next_cache[cache_position]};
+            cache_positions[vertex_index] =
+                cache_position < FORSYTH_CACHE_SIZE ? static_cast<std::int32_t>(cache_position) : -1;
+            vertex_scores[vertex_index] =
+                get_vertex_score(cache_positions[vertex_index], remaining_triangle_counts[vertex_index]);
+        }
+
+        // Only the triangles of the cached vertices changed scores, the next triangle is picked among them
+        best_triangle = NO_TRIANGLE;
+        float best_triangle_score{-1.0f};
+        for (std::uint32_t vertex_index : next_cache)
+        {
+            const std::uint32_t *triangles{&vertex_triangles[vertex_triangle_offsets[vertex_index]]};
+            for (std::uint32_t index{}; index < remaining_triangle_counts[vertex_index]; ++index)
+            {
+                std::uint32_t triangle{triangles[index]};
+                float triangle_score{
+                    vertex_scores[vertex_indices[triangle * 3]] + vertex_scores[vertex_indices[triangle * 3 + 1]] +
+                    vertex_scores[vertex_indices[triangle * 3 + 2]]
+                };
+                triangle_scores[triangle] = triangle_score;
+                if (triangle_score > best_triangle_score)
+                {
+                    best_triangle = triangle;
+                    best_triangle_score = triangle_score;
+                }
+            }
+        }
+
+        if (next_cache.size() > FORSYTH_CACHE_SIZE)
+            next_cache.resize(FORSYTH_CACHE_SIZE);
+        std::swap(cache, next_cache);
+    }
+
+    std::copy(optimized_vertex_indices.begin(), optimized_vertex_indices.end(), vertex_indices.begin());
+}
+
+void optimize_overdraw(
+    std::span<std::uint32_t> vertex_indices,
+    const Math::Vector3 *vertex_positions,
+    std::size_t vertex_count,
+    float acmr_threshold
+)
+{
+    std::vector<TriangleCluster> clusters{split_triangle_clusters(vertex_indices, vertex_count, acmr_threshold)};
+    if (clusters.size() < 2)
+        return;
+
+    Math::Vector3 mesh_centroid{};
+    for (std::uint32_t vertex_index : vertex_indices)
+        mesh_centroid += vertex_positions[vertex_index];
+    mesh_centroid /= static_cast<float>(vertex_indices.size());
+
+    // Clusters far along their average normal face outwards, they are likely to hide the rest of the mesh
+    for (TriangleCluster &cluster : clusters)
+    {
+        Math::Vector3 centroid{};
+        Math::Vector3 area_weighted_normal{};
+        for (std::size_t index{cluster.first_index}; index < cluster.first_index + cluster.index_count; index += 3)
+        {
+            const Math::Vector3 &position_0{vertex_positions[vertex_indices[index]]};
+            const Math::Vector3 &position_1{vertex_positions[vertex_indices[index + 1]]};
+            const Math::Vector3 &position_2{vertex_positions[vertex_indices[index + 2]]};
+            centroid += position_0 + position_1 + position_2;
+            area_weighted_normal += Math::cross(position_1 - position_0, position_2 - position_0);
+        }
+        centroid /= static_cast<float>(cluster.index_count);
+
+        float normal_length{Math::length(area_weighted_normal)};
+        if (normal_length > 0.0f)
+            cluster.sort_key = Math::dot(centroid - mesh_centroid, area_weighted_normal / normal_length);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const TriangleCluster &lhs, const TriangleCluster &rhs) {
+        return lhs.sort_key > rhs.sort_key;
+    });
+
+    std::vector<std::uint32_t> sorted_vertex_indices{};
+    sorted_vertex_indices.reserve(vertex_indices.size());
+    for (const TriangleCluster &cluster : clusters)
+    {
+        auto cluster_begin{vertex_indices.begin() + static_cast<std::ptrdiff_t>(cluster.first_index)};
+        sorted_vertex_indices.insert(
+            sorted_vertex_indices.end(), cluster_begin, cluster_begin + static_cast<std::ptrdiff_t>(cluster.index_count)
+        );
+    }
+    std::copy(sorted_vertex_indices.begin(), sorted_vertex_indices.end(), vertex_indices.begin());
+}
+
+std::vector<std::uint32_t> optimize_vertex_fetch(std::span<std::uint32_t> vertex_indices, std::size_t vertex_count)
+{
+    std::vector<std::uint32_t> new_vertex_indices(vertex_count, UNUSED_VERTEX);
+    std::vector<std::uint32_t> vertex_order{};
+    vertex_order.reserve(vertex_count);
+
+    for (std::uint32_t &vertex_index : vertex_indices)
+    {
+        if (new_vertex_indices[vertex_index] == UNUSED_VERTEX)
+        {
+            new_vertex_indices[vertex_index] = static_cast<std::uint32_t>(vertex_order.size());
+            vertex_order.push_back(vertex_index);
+        }
+        vertex_index = new_vertex_indices[vertex_index];
+    }
+
+    for (std::size_t index{}; index < vertex_count; ++index)
+    {
+        if (new_vertex_indices[index] == UNUSED_VERTEX)
+            vertex_order.push_back(static_cast<std::uint32_t>(index));
+    }
+    return vertex_order;
+}
+
+MeshOptimizationResult optimize_mesh(
+    std::span<std::uint32_t> vertex_indices, const Math::Vector3 *vertex_positions, std::size_t vertex_count
+)
+{
+    MeshOptimizationResult result{.acmr_before = compute_acmr(vertex_indices, vertex_count)};
+
+    optimize_vertex_cache(vertex_indices, vertex_count);
+    optimize_overdraw(vertex_indices, vertex_positions, vertex_count);
+    result.acmr_after = compute_acmr(vertex_indices, vertex_count);
+
+    result.vertex_order = optimize_vertex_fetch(vertex_indices, vertex_count);
+    return result;
+}
+} // namespace Age::Gfx
@@ -0,0 +1,394 @@
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define AGE_OCCLUSION_SSE
+#include <xmmintrin.h>
+#endif
+
+#include "OcclusionCulling.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+// Vertices closer to the camera plane are not projected
+constexpr float MIN_CLIP_W{1e-4f};
+constexpr float MIN_TRIANGLE_AREA{1e-6f};
+
+// Indexed by mesh id
+std::vector<OccluderMesh> s_occluder_meshes{};
+
+Math::Vector4 transform_position(const Math::Matrix4 &matrix, const Math::Vector3 &position)
+{
+    const Math::Vector4 &column_0{matrix[0]};
+    const Math::Vector4 &column_1{matrix[1]};
+    const Math::Vector4 &column_2{matrix[2]};
+    const Math::Vector4 &column_3{matrix[3]};
+    return {
+        column_0.x * position.x + column_1.x * position.y + column_2.x * position.z + column_3.x,
+        column_0.y * position.x + column_1.y * position.y + column_2.y * position.z + column_3.y,
+        column_0.z * position.x + column_1.z * position.y + column_2.z * position.z + column_3.z,
+        column_0.w * position.x + column_1.w * position.y + column_2.w * position.z + column_3.w
+    };
+}
+
+// Clip coordinates to buffer pixels and a depth in [0, 1]
+Math::Vector3 project_position(const Math::Vector4 &clip_position)
+{
+    float inverse_w{1.0f / clip_position.w};
+    return {
+        (clip_position.x * inverse_w * 0.5f + 0.5f) * OCCLUSION_BUFFER_WIDTH,
+        (clip_position.y * inverse_w * 0.5f + 0.5f) * OCCLUSION_BUFFER_HEIGHT,
+        clip_position.z * inverse_w * 0.5f + 0.5f
+    };
+}
+} // namespace
+
+void create_occluder_mesh(
+    MeshId mesh_id, std::span<const Math::Vector3> vertex_positions, std::span<const std::uint16_t> vertex_indices
+)
+{
+    if (mesh_id >= s_occluder_meshes.size())
+        s_occluder_meshes.resize(mesh_id + 1);
+
+    OccluderMesh &mesh{s_occluder_meshes[mesh_id]};
+    mesh.vertex_positions.assign(vertex_positions.begin(), vertex_positions.end());
+    mesh.vertex_indices.assign(vertex_indices.begin(), vertex_indices.end() - vertex_indices.size() % 3);
+}
+
+const OccluderMesh *get_occluder_mesh(MeshId mesh_id)
+{
+    if (mesh_id >= s_occluder_meshes.size() || s_occluder_meshes[mesh_id].vertex_indices.empty())
+        return nullptr;
+
+    return &s_occluder_meshes[mesh_id];
+}
+
+OcclusionBuffer::OcclusionBuffer()
+{
+    std::iota(_tile_indexes.begin(), _tile_indexes.end(), 0U);
+    for (std::size_t level{}; level < OCCLUSION_LEVEL_COUNT; ++level)
+        _depth_levels[level].resize((OCCLUSION_BUFFER_WIDTH >> level) * (OCCLUSION_BUFFER_HEIGHT >> level), 1.0f);
+}
+
+void OcclusionBuffer::begin(const Math::Matrix4 &world_to_clip_matrix)
+{
+    _world_to_clip_matrix = world_to_clip_matrix;
+    _triangles.clear();
+    for (std::vector<std::uint32_t> &triangle_indexes : _tile_triangle_indexes)
+        triangle_indexes.clear();
+
+    std::fill(_depth_levels[0].begin(), _depth_levels[0].end(), 1.0f);
+}
+
+void OcclusionBuffer::add_occluder(const Math::Matrix4 &local_to_world_matrix, const OccluderMesh &mesh)
+{
+    Math::Matrix4 lc_matrix{_world_to_clip_matrix * local_to_world_matrix};
+
+    _clip_positions.resize(mesh.vertex_positions.size());
+    for (std::size_t index{}; index < mesh.vertex_positions.size(); ++index)
+        _clip_positions[index] = transform_position(lc_matrix, mesh.vertex_positions[index]);
+
+    for (std::size_t index{}; index + 2 < mesh.vertex_indices.size(); index += 3)
+    {
+        add_triangle({
+            _clip_positions[mesh.vertex_indices[index]],
+            _clip_positions[mesh.vertex_indices[index + 1]],
+            _clip_positions[mesh.vertex_indices[index + 2]],
+        });
+    }
+}
+
+// Triangles crossing the near plane are dropped instead of clipped, which can only hide less.
+// Their vertices in front of it would get a negative depth and hide everything behind them.
+void OcclusionBuffer::add_triangle(const Math::Vector4 (&clip_positions)[3])
+{
+    for (const Math::Vector4 &clip_position : clip_positions)
+    {
+        if (clip_position.w < MIN_CLIP_W || clip_position.z < -clip_position.w)
+            return;
+    }
+
+    Math::Vector3 positions[3]{
+        project_position(clip_positions[0]), project_position(clip_positions[1]), project_position(clip_positions[2])
+    };
+
+    float area{
+        (positions[1].x - positions[0].x) * (positions[2].y - positions[0].y) -
+        (positions[2].x - positions[0].x) * (positions[1].y - positions[0].y)
+    };
+    if (std::abs(area) < MIN_TRIANGLE_AREA)
+        return;
+
+    // Occluders are rasterized without culling back faces
+    if (area < 0.0f)
+    {
+        std::swap(positions[1], positions[2]);
+        area = -area;
+    }
+
+    // Pixels whose center lies in the bounding box
+    float min_x{std::ceil(std::min({positions[0].x, positions[1].x, positions[2].x}) - 0.5f)};
+    float min_y{std::ceil(std::min({positions[0].y, positions[1].y, positions[2].y}) - 0.5f)};
+    float max_x{std::floor(std::max({positions[0].x, positions[1].x, positions[2].x}) - 0.5f)};
+    float max_y{std::floor(std::max({positions[0].y, positions[1].y, positions[2].y}) - 0.5f)};
+    min_x = std::max(min_x, 0.0f);
+    min_y = std::max(min_y, 0.0f);
+    max_x = std::min(max_x, static_cast<float>(OCCLUSION_BUFFER_WIDTH - 1));
+    max_y = std::min(max_y, static_cast<float>(OCCLUSION_BUFFER_HEIGHT - 1));
+    if (min_x > max_x || min_y > max_y)
+        return;
+
+    Triangle triangle{
+        .origin_x = positions[0].x,
+        .origin_y = positions[0].y,
+        .depth = positions[0].z,
+        .min_x = static_cast<std::uint16_t>(min_x),
+        .min_y = static_cast<std::uint16_t>(min_y),
+        .max_x = static_cast<std::uint16_t>(max_x),
+        .max_y = static_cast<std::uint16_t>(max_y)
+    };
+
+    // Positive inside counter-clockwise triangles
+    for (std::size_t index{}; index < 3; ++index)
+    {
+        const Math::Vector3 &start{positions[index]};
+        const Math::Vector3 &end{positions[(index + 1) % 3]};
+        triangle.edge_xs[index] = start.y - end.y;
+        triangle.edge_ys[index] = end.x - start.x;
+        triangle.edge_offsets[index] = triangle.edge_xs[index] * (positions[0].x - start.x) +
+                                       triangle.edge_ys[index] * (positions[0].y - start.y);
+    }
+
+    float depth_1{positions[1].z - positions[0].z};
+    float depth_2{positions[2].z - positions[0].z};
+    triangle.depth_dx =
+        (depth_1 * (positions[2].y - positions[0].y) - depth_2 * (positions[1].y - positions[0].y)) / area;
+    triangle.depth_dy =
+        (depth_2 * (positions[1].x - positions[0].x) - depth_1 * (positions[2].x - positions[0].x)) / area;
+
+    auto triangle_index{static_cast<std::uint32_t>(_triangles.size())};
+    _triangles.push_back(triangle);
+
+    for (std::size_t row{triangle.min_y / OCCLUSION_TILE_SIZE}; row <= triangle.max_y / OCCLUSION_TILE_SIZE; ++row)
+    {
+        for (std::size_t column{triangle.min_x / OCCLUSION_TILE_SIZE};
+             column <= triangle.max_x / OCCLUSION_TILE_SIZE;
+             ++column)
+            _tile_triangle_indexes[row * TILE_COLUMN_COUNT + column].push_back(triangle_index);
+    }
+}
+
+void OcclusionBuffer::rasterize()
+{
+    // Tiles do not share pixels so they are written without synchronization
+    std::for_each(std::execution::par, _tile_indexes.begin(), _tile_indexes.end(), [this](std::uint32_t tile_index) {
+        rasterize_tile(tile_index);
+    });
+
+    build_depth_pyramid();
+}
+
+void OcclusionBuffer::rasterize_tile(std::uint32_t tile_index)
+{
+    std::size_t tile_min_x{tile_index % TILE_COLUMN_COUNT * OCCLUSION_TILE_SIZE};
+    std::size_t tile_min_y{tile_index / TILE_COLUMN_COUNT * OCCLUSION_TILE_SIZE};
+    std::size_t tile_max_x{tile_min_x + OCCLUSION_TILE_SIZE - 1};
+    std::size_t tile_max_y{tile_min_y + OCCLUSION_TILE_SIZE - 1};
+
+    float *depths{_depth_levels[0].data()};
+    for (std::uint32_t triangle_index : _tile_triangle_indexes[tile_index])
+    {
+        const Triangle &triangle{_triangles[triangle_index]};
+
+        std::size_t min_x{std::max<std::size_t>(triangle.min_x, tile_min_x)};
+        std::size_t min_y{std::max<std::size_t>(triangle.min_y, tile_min_y)};
+        std::size_t max_x{std::min<std::size_t>(triangle.max_x, tile_max_x)};
+        std::size_t max_y{std::min<std::size_t>(triangle.max_y, tile_max_y)};
+
+#ifdef AGE_OCCLUSION_SSE
+        // Groups of 4 pixels stay in the tile since its size is a multiple of 4,
+        // the pixels of a group outside of the bounding box fail the edge tests
+        min_x &= ~std::size_t{3};
+
+        __m128 lane_offsets{_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f)};
+        __m128 edge_xs[3]{
+            _mm_set1_ps(triangle.edge_xs[0]), _mm_set1_ps(triangle.edge_xs[1]), _mm_set1_ps(triangle.edge_xs[2])
+        };
+        __m128 depth_dx{_mm_set1_ps(triangle.depth_dx)};
+        __m128 zero{_mm_setzero_ps()};
+
+        for (std::size_t y{min_y}; y <= max_y; ++y)
+        {
+            float pixel_y{static_cast<float>(y) + 0.5f - triangle.origin_y};
+            __m128 edge_rows[3]{
+                _mm_set1_ps(triangle.edge_ys[0] * pixel_y + triangle.edge_offsets[0]),
+                _mm_set1_ps(triangle.edge_ys[1] * pixel_y + triangle.edge_offsets[1]),
+                _mm_set1_ps(triangle.edge_ys[2] * pixel_y + triangle.edge_offsets[2])
+            };
+            __m128 depth_row{_mm_set1_ps(triangle.depth + triangle.depth_dy * pixel_y)};
+
+            float *row{depths + y * OCCLUSION_BUFFER_WIDTH};
+            for (std::size_t x{min_x}; x <= max_x; x += 4)
+            {
+                __m128 pixel_x{_mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f - triangle.origin_x), lane_offsets)};
+
+                __m128 inside{_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_xs[0], pixel_x), edge_rows[0]), zero)};
+                for (std::size_t index{1}; index < 3; ++index)
+                {
+                    __m128 edge{_mm_add_ps(_mm_mul_ps(edge_xs[index], pixel_x), edge_rows[index])};
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(edge, zero));
+                }
+                if (_mm_movemask_ps(inside) == 0)
+                    continue;
+
+                __m128 old_depth{_mm_loadu_ps(row + x)};
+                __m128 new_depth{_mm_min_ps(old_depth, _mm_add_ps(_mm_mul_ps(depth_dx, pixel_x), depth_row))};
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, new_depth), _mm_andnot_ps(inside, old_depth)));
+            }
+        }
+#else
+        for (std::size_t y{min_y}; y <= max_y; ++y)
+        {
+            float pixel_y{static_cast<float>(y) + 0.5f - triangle.origin_y};
+            float *row{depths + y * OCCLUSION_BUFFER_WIDTH};
+            for (std::size_t x{min_x}; x <= max_x; ++x)
+            {
+                float pixel_x{static_cast<float>(x) + 0.5f - triangle.origin_x};
+
+                bool is_inside{true};
+                for (std::size_t index{}; index < 3; ++index)
+                {
+                    float edge{
+                        triangle.edge_xs[index] * pixel_x + triangle.edge_ys[index] * pixel_y +
+                        triangle.edge_offsets[index]
+                    };
+                    is_inside = is_inside && edge >= 0.0f;
+                }
+                if (is_inside)
+                {
+                    float depth{triangle.depth + triangle.depth_dx * pixel_x + triangle.depth_dy * pixel_y};
+                    row[x] = std::min(row[x], depth);
+                }
+            }
+        }
+#endif
+    }
+}
+
+void OcclusionBuffer::build_depth_pyramid()
+{
+    for (std::size_t level{1}; level < OCCLUSION_LEVEL_COUNT; ++level)
+    {
+        const float *source_depths{_depth_levels[level - 1].data()};
+        float *depths{_depth_levels[level].data()};
+        std::size_t source_width{OCCLUSION_BUFFER_WIDTH >> (level - 1)};
+        std::size_t width{OCCLUSION_BUFFER_WIDTH >> level};
+        std::size_t height{OCCLUSION_BUFFER_HEIGHT >> level};
+
+        for (std::size_t y{}; y < height; ++y)
+        {
+            const float *source_row_0{source_depths + 2 * y * source_width};
+            const float *source_row_1{source_row_0 + source_width};
+            float *row{depths + y * width};
+
+            std::size_t x{};
+#ifdef AGE_OCCLUSION_SSE
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128 max_0{_mm_max_ps(_mm_loadu_ps(source_row_0 + 2 * x), _mm_loadu_ps(source_row_1 + 2 * x))};
+                __m128 max_1{
+                    _mm_max_ps(_mm_loadu_ps(source_row_0 + 2 * x + 4), _mm_loadu_ps(source_row_1 + 2 * x + 4))
+                };
+                __m128 evens{_mm_shuffle_ps(max_0, max_1, _MM_SHUFFLE(2, 0, 2, 0))};
+                __m128 odds{_mm_shuffle_ps(max_0, max_1, _MM_SHUFFLE(3, 1, 3, 1))};
+                _mm_storeu_ps(row + x, _mm_max_ps(evens, odds));
+            }
+#endif
+            for (; x < width; ++x)
+            {
+                row[x] = std::max(
+                    {source_row_0[2 * x], source_row_0[2 * x + 1], source_row_1[2 * x], source_row_1[2 * x + 1]}
+                );
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::is_sphere_occluded(const Math::Vector3 &center, float radius) const
+{
+    if (radius < 0.0f)
+        return false;
+
+    // Projects the corners of the box around the sphere
+    Math::Vector4 clip_center{transform_position(_world_to_clip_matrix, center)};
+    Math::Vector4 clip_axes[3];
+    for (std::size_t index{}; index < 3; ++index)
+    {
+        const Math::Vector4 &column{_world_to_clip_matrix[index]};
+        clip_axes[index] = {column.x * radius, column.y * radius, column.z * radius, column.w * radius};
+    }
+
+    float min_x{INFINITY};
+    float min_y{INFINITY};
+    float max_x{-INFINITY};
+    float max_y{-INFINITY};
+    float min_depth{INFINITY};
+    for (std::size_t corner{}; corner < 8; ++corner)
+    {
+        Math::Vector4 clip_position{clip_center};
+        for (std::size_t index{}; index < 3; ++index)
+        {
+            float sign{(corner >> index & 1) != 0 ? 1.0f : -1.0f};
+            clip_position.x += sign * clip_axes[index].x;
+            clip_position.y += sign * clip_axes[index].y;
+            clip_position.z += sign * clip_axes[index].z;
+            clip_position.w += sign * clip_axes[index].w;
+        }
+        if (clip_position.w < MIN_CLIP_W)
+            return false;
+
+        Math::Vector3 position{project_position(clip_position)};
+        min_x = std::min(min_x, position.x);
+        min_y = std::min(min_y, position.y);
+        max_x = std::max(max_x, position.x);
+        max_y = std::max(max_y, position.y);
+        min_depth = std::min(min_depth, position.z);
+    }
+
+    // Off screen bounds are left to the frustum test
+    if (max_x < 0.0f || max_y < 0.0f || min_x >= OCCLUSION_BUFFER_WIDTH || min_y >= OCCLUSION_BUFFER_HEIGHT)
+        return false;
+
+    auto pixel_min_x{static_cast<std::size_t>(std::max(min_x, 0.0f))};
+    auto pixel_min_y{static_cast<std::size_t>(std::max(min_y, 0.0f))};
+    auto pixel_max_x{static_cast<std::size_t>(std::min(max_x, static_cast<float>(OCCLUSION_BUFFER_WIDTH - 1)))};
+    auto pixel_max_y{static_cast<std::size_t>(std::min(max_y, static_cast<float>(OCCLUSION_BUFFER_HEIGHT - 1)))};
+
+    // Picks the level where the rectangle covers at most 3x3 texels
+    std::size_t size{std::max(pixel_max_x - pixel_min_x, pixel_max_y - pixel_min_y) + 1};
+    std::size_t level{};
+    while ((size >> level) > 2 && level + 1 < OCCLUSION_LEVEL_COUNT)
+        ++level;
+
+    const float *depths{_depth_levels[level].data()};
+    std::size_t width{OCCLUSION_BUFFER_WIDTH >> level};
+    for (std::size_t y{pixel_min_y >> level}; y <= pixel_max_y >> level; ++y)
+    {
+        for (std::size_t x{pixel_min_x >> level}; x <= pixel_max_x >> level; ++x)
+        {
+            if (depths[y * width + x] >= min_depth)
+                return false;
+        }
+    }
+    return true;
+}
+
+float OcclusionBuffer::get_depth(std::size_t level, std::size_t x, std::size_t y) const
+{
+    return _depth_levels[level][y * (OCCLUSION_BUFFER_WIDTH >> level) + x];
+}
+} // namespace Age::Gfx
@@ -1,8 +1,181 @@
+#include <vector>
+
 #include "OpenGL.hpp"
 #include "ErrorHandling.hpp"
+#include "RenderStats.hpp"
 
 namespace Age::Gfx::OGL
 {
+namespace
+{
+constexpr GLenum s_capability_to_gl_enum[] = {
+    GL_CULL_FACE, GL_DEPTH_TEST, GL_DEPTH_CLAMP, GL_SCISSOR_TEST, GL_FRAMEBUFFER_SRGB
+};
+
+constexpr std::size_t CAPABILITY_COUNT{std::size(s_capability_to_gl_enum)};
+
+constexpr GLenum to_gl_enum(Capability capability)
+{
+    return s_capability_to_gl_enum[static_cast<std::size_t>(capability)];
+}
+
+// Only the targets used by the texture system are shadowed
+constexpr std::size_t TEXTURE_TARGET_COUNT{4};
+
+constexpr std::size_t get_texture_target_index(GLenum target)
+{
+    switch (target)
+    {
+    case GL_TEXTURE_1D:
+        return 0;
+    case GL_TEXTURE_2D:
+        return 1;
+    case GL_TEXTURE_CUBE_MAP:
+        return 2;
+    case GL_TEXTURE_3D:
+        return 3;
+    default:
+        return TEXTURE_TARGET_COUNT;
+    }
+}
+
+struct TextureUnitState
+{
+    GLuint textures[TEXTURE_TARGET_COUNT]{};
+    GLuint sampler{};
+};
+
+struct BufferRangeState
+{
+    GLuint buffer{};
+    std::size_t offset{};
+    std::size_t size{};
+};
+
+struct Rectangle
+{
+    GLint x{};
+    GLint y{};
+    GLsizei width{};
+    GLsizei height{};
+
+    bool operator==(const Rectangle &) const = default;
+};
+
+// The default viewport and scissor box are the window size, so the first calls are never filtered
+struct State
+{
+    GLuint shader_program{};
+    GLuint vertex_array_object{};
+    GLuint array_buffer{};
+    GLuint uniform_buffer{};
+    GLuint active_texture_unit{};
+    std::vector<TextureUnitState> texture_units{};
+    std::vector<BufferRangeState> uniform_buffer_ranges{};
+    bool capabilities[CAPABILITY_COUNT]{};
+    Rectangle viewport{-1, -1, -1, -1};
+    Rectangle scissor_box{-1, -1, -1, -1};
+    Math::Vector4 clear_color{0.0f};
+    float clear_depth{1.0f};
+};
+
+State s_state{};
+StateCallCounters s_state_call_counters{};
+
+bool filter_redundant_call(bool is_redundant)
+{
+    if (is_redundant)
+        ++s_state_call_counters.filtered_call_count;
+    else
+        ++s_state_call_counters.issued_call_count;
+    return is_redundant;
+}
+
+// Strips and fans share vertices between consecutive primitives
+std::uint32_t get_triangle_count(RenderingMode rendering_mode, std::uint32_t element_count)
+{
+    switch (rendering_mode)
+    {
+    case RenderingMode::TRIANGLES:
+        return element_count / 3;
+    case RenderingMode::TRIANGLE_STRIP:
+    case RenderingMode::TRIANGLE_FAN:
+        return element_count < 3 ? 0 : element_count - 2;
+    case RenderingMode::TRIANGLES_ADJACENCY:
+        return element_count / 6;
+    case RenderingMode::TRIANGLE_STRIP_ADJACENCY:
+        return element_count < 6 ? 0 : (element_count - 4) / 2;
+    default:
+        return 0;
+    }
+}
+
+void count_draw(RenderingMode rendering_mode, std::uint32_t element_count, std::uint32_t instance_count)
+{
+    ++g_render_stats.draw_call_count;
+    g_render_stats.instance_count += instance_count;
+    g_render_stats.vertex_count += static_cast<std::uint64_t>(element_count) * instance_count;
+    g_render_stats.triangle_count +=
+        static_cast<std::uint64_t>(get_triangle_count(rendering_mode, element_count)) * instance_count;
+}
+
+void count_instanced_draw(RenderingMode rendering_mode, std::uint32_t element_count, std::uint32_t instance_count)
+{
+    ++g_render_stats.instanced_draw_call_count;
+    count_draw(rendering_mode, element_count, instance_count);
+}
+
+// A multi draw is a single draw call submitting several draws
+void count_multi_draw(RenderingMode rendering_mode, const GLsizei *element_counts, std::uint32_t draw_count)
+{
+    ++g_render_stats.draw_call_count;
+    ++g_render_stats.multi_draw_call_count;
+    g_render_stats.multi_drawn_draw_count += draw_count;
+    for (std::uint32_t index{}; index < draw_count; ++index)
+    {
+        auto element_count{static_cast<std::uint32_t>(element_counts[index])};
+        ++g_render_stats.instance_count;
+        g_render_stats.vertex_count += element_count;
+        g_render_stats.triangle_count += get_triangle_count(rendering_mode, element_count);
+    }
+}
+
+TextureUnitState &get_texture_unit_state(GLuint texture_unit)
+{
+    if (texture_unit >= s_state.texture_units.size())
+        s_state.texture_units.resize(texture_unit + 1);
+    return s_state.texture_units[texture_unit];
+}
+
+void set_active_texture_unit(GLuint texture_unit)
+{
+    if (filter_redundant_call(s_state.active_texture_unit == texture_unit))
+        return;
+
+    glActiveTexture(GL_TEXTURE0 + texture_unit);
+    s_state.active_texture_unit = texture_unit;
+}
+
+void bind_uniform_buffer(GLuint uniform_buffer)
+{
+    if (filter_redundant_call(s_state.uniform_buffer == uniform_buffer))
+        return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+    s_state.uniform_buffer = uniform_buffer;
+}
+} // namespace
+
+StateCallCounters get_state_call_counters()
+{
+    return s_state_call_counters;
+}
+
+void reset_state_call_counters()
+{
+    s_state_call_counters = {};
+}
+
 GLint get_integer(GLenum param_name)
 {
     GLint value;
@@ -17,7 +190,12 @@ GLuint create_shader(ShaderType shader_type)
 
 void use_shader(GLuint shader_program)
 {
+    if (filter_redundant_call(s_state.shader_program == shader_program))
+        return;
+
     glUseProgram(shader_program);
+    ++g_render_stats.shader_switch_count;
+    s_state.shader_program = shader_program;
 }
 
 GLint get_uniform_location(GLuint shader_program, std::string_view name)
@@ -74,28 +252,38 @@ void bind_uniform_block(GLuint shader_program, GLuint block_index, GLuint block_
     glUniformBlockBinding(shader_program, block_index, block_binding);
 }
 
+void bind_array_buffer(GLuint array_buffer_object)
+{
+    if (filter_redundant_call(s_state.array_buffer == array_buffer_object))
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, array_buffer_object);
+    s_state.array_buffer = array_buffer_object;
+}
+
 void write_array_buffer(GLuint array_buffer_object, const void *data, std::size_t size)
 {
-    write_uniform_buffer(array_buffer_object, 0, data, size);
+    write_array_buffer(array_buffer_object, 0, data, size);
 }
 
 void write_array_buffer(GLuint array_buffer_object, std::size_t offset, const void *data, std::size_t size)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, array_buffer_object);
+    bind_array_buffer(array_buffer_object);
     glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    g_render_stats.uploaded_byte_count += size;
 }
 
 GLuint create_uniform_buffer()
 {
     GLuint uniform_buffer;
     glGenBuffers(1, &uniform_buffer);
-    glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+    bind_uniform_buffer(uniform_buffer);
     return uniform_buffer;
 }
 
 void allocate_uniform_buffer(GLuint uniform_buffer, std::size_t size)
 {
-    glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+    bind_uniform_buffer(uniform_buffer);
     glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
 }
 
@@ -106,57 +294,232 @@ void write_uniform_buffer(GLuint uniform_buffer, const void *data, std::size_t s
 
 void write_uniform_buffer(GLuint uniform_buffer, std::size_t offset, const void *data, std::size_t size)
 {
-    glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+    bind_uniform_buffer(uniform_buffer);
     glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    g_render_stats.uploaded_byte_count += size;
+}
+
+void *map_uniform_buffer(GLuint uniform_buffer, std::size_t offset, std::size_t size, GLbitfield access)
+{
+    bind_uniform_buffer(uniform_buffer);
+    if (access & GL_MAP_WRITE_BIT)
+        g_render_stats.uploaded_byte_count += size;
+    return glMapBufferRange(GL_UNIFORM_BUFFER, offset, size, access);
+}
+
+void unmap_uniform_buffer(GLuint uniform_buffer)
+{
+    bind_uniform_buffer(uniform_buffer);
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
 }
 
 void bind_uniform_buffer_range(GLuint binding_point, GLuint uniform_buffer, std::size_t size)
 {
-    glBindBufferRange(GL_UNIFORM_BUFFER, binding_point, uniform_buffer, 0, size);
+    bind_uniform_buffer_range(binding_point, uniform_buffer, 0, size);
 }
 
 void bind_uniform_buffer_range(GLuint binding_point, GLuint uniform_buffer, std::size_t offset, std::size_t size)
 {
+    if (binding_point >= s_state.uniform_buffer_ranges.size())
+        s_state.uniform_buffer_ranges.resize(binding_point + 1);
+
+    BufferRangeState &range{s_state.uniform_buffer_ranges[binding_point]};
+    if (filter_redundant_call(range.buffer == uniform_buffer && range.offset == offset && range.size == size))
+        return;
+
     glBindBufferRange(GL_UNIFORM_BUFFER, binding_point, uniform_buffer, offset, size);
+    ++g_render_stats.uniform_buffer_bind_count;
+    range = {uniform_buffer, offset, size};
+    // The generic binding point is also changed
+    s_state.uniform_buffer = uniform_buffer;
 }
 
 void bind_vertex_array_object(GLuint vao)
 {
+    if (filter_redundant_call(s_state.vertex_array_object == vao))
+        return;
+
     glBindVertexArray(vao);
+    ++g_render_stats.vertex_array_bind_count;
+    s_state.vertex_array_object = vao;
 }
 
-void enable_srgb_rendering(bool enable)
+void bind_texture(GLuint texture_unit, GLenum target, GLuint texture)
 {
+    set_active_texture_unit(texture_unit);
+
+    std::size_t target_index{get_texture_target_index(target)};
+    TextureUnitState &texture_unit_state{get_texture_unit_state(texture_unit)};
+    if (target_index == TEXTURE_TARGET_COUNT)
+    {
+        filter_redundant_call(false);
+        glBindTexture(target, texture);
+        ++g_render_stats.texture_bind_count;
+        return;
+    }
+
+    if (filter_redundant_call(texture_unit_state.textures[target_index] == texture))
+        return;
+
+    glBindTexture(target, texture);
+    ++g_render_stats.texture_bind_count;
+    texture_unit_state.textures[target_index] = texture;
+}
+
+void bind_sampler(GLuint texture_unit, GLuint sampler)
+{
+    TextureUnitState &texture_unit_state{get_texture_unit_state(texture_unit)};
+    if (filter_redundant_call(texture_unit_state.sampler == sampler))
+        return;
+
+    glBindSampler(texture_unit, sampler);
+    ++g_render_stats.sampler_bind_count;
+    texture_unit_state.sampler = sampler;
+}
+
+void set_capability(Capability capability, bool enable)
+{
+    bool &is_enabled{s_state.capabilities[static_cast<std::size_t>(capability)]};
+    if (filter_redundant_call(is_enabled == enable))
+        return;
+
     if (enable)
-        glEnable(GL_FRAMEBUFFER_SRGB);
+        glEnable(to_gl_enum(capability));
     else
-        glDisable(GL_FRAMEBUFFER_SRGB);
+        glDisable(to_gl_enum(capability));
+    is_enabled = enable;
+}
+
+void enable_srgb_rendering(bool enable)
+{
+    set_capability(Capability::FRAMEBUFFER_SRGB, enable);
+}
+
+void set_viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    Rectangle viewport{x, y, width, height};
+    if (filter_redundant_call(s_state.viewport == viewport))
+        return;
+
+    glViewport(x, y, width, height);
+    s_state.viewport = viewport;
+}
+
+void set_scissor_box(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    Rectangle scissor_box{x, y, width, height};
+    if (filter_redundant_call(s_state.scissor_box == scissor_box))
+        return;
+
+    glScissor(x, y, width, height);
+    s_state.scissor_box = scissor_box;
 }
 
 void set_clear_color(const Math::Vector4 &color)
 {
+    if (filter_redundant_call(s_state.clear_color == color))
+        return;
+
     glClearColor(color.x, color.y, color.z, color.w);
+    s_state.clear_color = color;
 }
 
 void set_clear_depth(float depth)
 {
+    if (filter_redundant_call(s_state.clear_depth == depth))
+        return;
+
     glClearDepth(depth);
+    s_state.clear_depth = depth;
+}
+
+void clear(GLbitfield buffers)
+{
+    glClear(buffers);
+}
+
+std::size_t get_index_size(IndexType index_type)
+{
+    return index_type == IndexType::UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
 }
 
 void draw_arrays(RenderingMode rendering_mode, std::uint32_t element_count, std::size_t start_index)
 {
+    count_draw(rendering_mode, element_count, 1);
     glDrawArrays(
         static_cast<GLenum>(rendering_mode), static_cast<GLint>(start_index), static_cast<GLsizei>(element_count)
     );
 }
 
-void draw_elements(RenderingMode rendering_mode, std::uint32_t element_count, std::size_t buffer_offset)
+void draw_elements(
+    RenderingMode rendering_mode,
+    std::uint32_t element_count,
+    IndexType index_type,
+    std::size_t buffer_offset,
+    std::int32_t base_vertex
+)
+{
+    count_draw(rendering_mode, element_count, 1);
+    glDrawElementsBaseVertex(
+        static_cast<GLenum>(rendering_mode),
+        static_cast<GLsizei>(element_count),
+        static_cast<GLenum>(index_type),
+        reinterpret_cast<void *>(buffer_offset),
+        base_vertex
+    );
+}
+
+void multi_draw_elements(
+    RenderingMode rendering_mode,
+    IndexType index_type,
+    const GLsizei *element_counts,
+    const void *const *buffer_offsets,
+    const GLint *base_vertices,
+    std::uint32_t draw_count
+)
+{
+    count_multi_draw(rendering_mode, element_counts, draw_count);
+    // Some loaders declare the base vertices without const
+    glMultiDrawElementsBaseVertex(
+        static_cast<GLenum>(rendering_mode),
+        element_counts,
+        static_cast<GLenum>(index_type),
+        buffer_offsets,
+        static_cast<GLsizei>(draw_count),
+        const_cast<GLint *>(base_vertices)
+    );
+}
+
+void draw_arrays_instanced(
+    RenderingMode rendering_mode, std::uint32_t element_count, std::size_t start_index, std::uint32_t instance_count
+)
+{
+    count_instanced_draw(rendering_mode, element_count, instance_count);
+    glDrawArraysInstanced(
+        static_cast<GLenum>(rendering_mode),
+        static_cast<GLint>(start_index),
+        static_cast<GLsizei>(element_count),
+        static_cast<GLsizei>(instance_count)
+    );
+}
+
+void draw_elements_instanced(
+    RenderingMode rendering_mode,
+    std::uint32_t element_count,
+    IndexType index_type,
+    std::size_t buffer_offset,
+    std::uint32_t instance_count,
+    std::int32_t base_vertex
+)
 {
-    glDrawElements(
+    count_instanced_draw(rendering_mode, element_count, instance_count);
+    glDrawElementsInstancedBaseVertex(
         static_cast<GLenum>(rendering_mode),
         static_cast<GLsizei>(element_count),
-        GL_UNSIGNED_SHORT,
-        reinterpret_cast<const void *>(buffer_offset)
+        static_cast<GLenum>(index_type),
+        reinterpret_cast<void *>(buffer_offset),
+        static_cast<GLsizei>(instance_count),
+        base_vertex
     );
 }
 } // namespace Age::Gfx::OGL
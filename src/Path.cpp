@@ -6,22 +6,23 @@ namespace Age::Core
 void move_along_path(Transform &transform, PathFollower &path_follower)
 {
     Math::Vector3 offset_to_target{path_follower.target_position - transform.position};
+    std::span<Math::Vector3> path{get_blob_data(path_follower.path)};
 
     if (Math::length(offset_to_target) <= path_follower.target_min_distance)
     {
-        if (path_follower.target_index == path_follower.path.size() - 1)
+        if (path_follower.target_index == path.size() - 1)
         {
             if (path_follower.repeat_path == false)
                 return;
 
             path_follower.target_index = 0;
-            path_follower.target_position = path_follower.path[0];
+            path_follower.target_position = path[0];
             offset_to_target = path_follower.target_position - transform.position;
         }
         else
         {
             ++path_follower.target_index;
-            path_follower.target_position = path_follower.path[path_follower.target_index];
+            path_follower.target_position = path[path_follower.target_index];
             offset_to_target = path_follower.target_position - transform.position;
         }
     }
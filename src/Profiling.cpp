@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "ErrorHandling.hpp"
+#include "OpenGL.hpp"
+#include "Profiling.hpp"
+
+namespace Age::Core
+{
+namespace
+{
+constexpr std::size_t THREAD_ZONE_COUNT{4096};
+// Queries are read back when their frame slot is reused, this many frames after being issued
+constexpr std::size_t GPU_QUERY_FRAME_COUNT{4};
+constexpr std::size_t MAX_GPU_ZONE_COUNT_PER_FRAME{32};
+
+using Clock = std::chrono::steady_clock;
+
+// Only written by its thread, only read at the end of the frame
+struct ThreadZones
+{
+    std::uint32_t thread_index{};
+    std::uint32_t depth{};
+    std::uint64_t written_zone_count{};
+    std::uint64_t dumped_zone_count{};
+    std::array<ProfileZone, THREAD_ZONE_COUNT> zones{};
+};
+
+struct GpuFrameQueries
+{
+    std::array<GLuint, MAX_GPU_ZONE_COUNT_PER_FRAME> queries{};
+    std::array<std::string_view, MAX_GPU_ZONE_COUNT_PER_FRAME> zone_names{};
+    std::array<std::uint64_t, MAX_GPU_ZONE_COUNT_PER_FRAME> zone_start_times{};
+    std::uint32_t used_query_count{};
+};
+
+std::uint32_t s_dump_interval{};
+std::string_view s_dump_path{};
+
+Clock::time_point s_start_time{Clock::now()};
+std::uint64_t s_frame_index{};
+
+std::mutex s_thread_zones_mutex{};
+std::vector<std::unique_ptr<ThreadZones>> s_thread_zones{};
+thread_local ThreadZones *t_thread_zones{};
+
+std::array<GpuFrameQueries, GPU_QUERY_FRAME_COUNT> s_gpu_frame_queries{};
+std::vector<ProfileZone> s_gpu_zones{};
+std::uint64_t s_dropped_gpu_zone_count{};
+
+std::uint64_t get_time_ns()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - s_start_time).count()
+    );
+}
+
+ThreadZones &get_thread_zones()
+{
+    if (t_thread_zones != nullptr)
+        return *t_thread_zones;
+
+    std::lock_guard lock{s_thread_zones_mutex};
+    auto &thread_zones{s_thread_zones.emplace_back(std::make_unique<ThreadZones>())};
+    thread_zones->thread_index = static_cast<std::uint32_t>(s_thread_zones.size() - 1);
+    t_thread_zones = thread_zones.get();
+    return *t_thread_zones;
+}
+
+GpuFrameQueries &get_current_gpu_frame_queries()
+{
+    return s_gpu_frame_queries[s_frame_index % GPU_QUERY_FRAME_COUNT];
+}
+
+// Queries not available yet are dropped, the slot is about to be reused
+void read_gpu_queries(GpuFrameQueries &frame_queries)
+{
+    for (std::uint32_t index{}; index < frame_queries.used_query_count; ++index)
+    {
+        GLint is_available{};
+        glGetQueryObjectiv(frame_queries.queries[index], GL_QUERY_RESULT_AVAILABLE, &is_available);
+        if (is_available == GL_FALSE)
+        {
+            ++s_dropped_gpu_zone_count;
+            continue;
+        }
+
+        GLuint64 elapsed_time_ns{};
+        glGetQueryObjectui64v(frame_queries.queries[index], GL_QUERY_RESULT, &elapsed_time_ns);
+        s_gpu_zones.push_back(
+            {.name = frame_queries.zone_names[index],
+             .start_ns = frame_queries.zone_start_times[index],
+             .end_ns = frame_queries.zone_start_times[index] + elapsed_time_ns,
+             .thread_index = GPU_THREAD_INDEX}
+        );
+    }
+    frame_queries.used_query_count = 0;
+}
+
+void dump_profile_zones()
+{
+    std::vector<ProfileZone> zones{get_profile_zones()};
+
+    if (s_dump_path.empty())
+        log_profile_zones(zones);
+    else
+        write_chrome_trace(zones, s_dump_path);
+
+    for (auto &thread_zones : s_thread_zones)
+        thread_zones->dumped_zone_count = thread_zones->written_zone_count;
+    s_gpu_zones.clear();
+}
+
+// Names are written as is, they are expected to be identifiers
+void write_trace_event(std::ofstream &file, const ProfileZone &zone)
+{
+    file << "{\"name\": \"" << zone.name;
+    file << "\", \"cat\": \"" << (zone.thread_index == GPU_THREAD_INDEX ? "gpu" : "cpu");
+    file << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << zone.thread_index;
+    file << ", \"ts\": " << static_cast<double>(zone.start_ns) / 1000.0;
+    file << ", \"dur\": " << static_cast<double>(zone.end_ns - zone.start_ns) / 1000.0 << "}";
+}
+} // namespace
+
+CpuProfileScope::CpuProfileScope(std::string_view name)
+    : _name{name}
+    , _start_ns{get_time_ns()}
+{
+    ++get_thread_zones().depth;
+}
+
+CpuProfileScope::~CpuProfileScope()
+{
+    ThreadZones &thread_zones{get_thread_zones()};
+    --thread_zones.depth;
+
+    thread_zones.zones[thread_zones.written_zone_count % THREAD_ZONE_COUNT] = {
+        .name = _name,
+        .start_ns = _start_ns,
+        .end_ns = get_time_ns(),
+        .thread_index = thread_zones.thread_index,
+        .depth = thread_zones.depth
+    };
+    ++thread_zones.written_zone_count;
+}
+
+GpuProfileScope::GpuProfileScope(std::string_view name)
+    : _is_query_started{}
+{
+    GpuFrameQueries &frame_queries{get_current_gpu_frame_queries()};
+    if (frame_queries.used_query_count == MAX_GPU_ZONE_COUNT_PER_FRAME)
+    {
+        ++s_dropped_gpu_zone_count;
+        return;
+    }
+
+    std::uint32_t index{frame_queries.used_query_count++};
+    frame_queries.zone_names[index] = name;
+    frame_queries.zone_start_times[index] = get_time_ns();
+    glBeginQuery(GL_TIME_ELAPSED, frame_queries.queries[index]);
+    _is_query_started = true;
+}
+
+GpuProfileScope::~GpuProfileScope()
+{
+    if (_is_query_started)
+        glEndQuery(GL_TIME_ELAPSED);
+}
+
+void init_profiling(const App::Definitions &definitions)
+{
+    s_dump_interval = definitions.profile_dump_interval;
+    s_dump_path = definitions.profile_dump_path;
+
+    // The main thread is the first one
+    get_thread_zones();
+
+    for (GpuFrameQueries &frame_queries : s_gpu_frame_queries)
+        glGenQueries(static_cast<GLsizei>(frame_queries.queries.size()), frame_queries.queries.data());
+    s_gpu_zones.reserve(GPU_QUERY_FRAME_COUNT * MAX_GPU_ZONE_COUNT_PER_FRAME);
+}
+
+std::vector<ProfileZone> get_profile_zones()
+{
+    std::vector<ProfileZone> zones{s_gpu_zones};
+    for (auto &thread_zones : s_thread_zones)
+    {
+        // Zones overwritten since the last dump are lost
+        std::uint64_t kept_zone_count{std::min<std::uint64_t>(thread_zones->written_zone_count, THREAD_ZONE_COUNT)};
+        std::uint64_t first_zone_index{
+            std::max(thread_zones->dumped_zone_count, thread_zones->written_zone_count - kept_zone_count)
+        };
+        for (std::uint64_t index{first_zone_index}; index < thread_zones->written_zone_count; ++index)
+            zones.push_back(thread_zones->zones[index % THREAD_ZONE_COUNT]);
+    }
+    return zones;
+}
+
+void log_profile_zones(std::span<const ProfileZone> zones)
+{
+    struct ZoneTotal
+    {
+        std::string_view name{};
+        std::uint32_t thread_index{};
+        std::uint32_t depth{};
+        std::uint64_t call_count{};
+        std::uint64_t total_time_ns{};
+    };
+
+    std::vector<ZoneTotal> zone_totals{};
+    for (const ProfileZone &zone : zones)
+    {
+        auto zone_total{std::find_if(zone_totals.begin(), zone_totals.end(), [&](const ZoneTotal &total) {
+            return total.name == zone.name && total.thread_index == zone.thread_index && total.depth == zone.depth;
+        })};
+        if (zone_total == zone_totals.end())
+            zone_total = zone_totals.insert(zone_totals.end(), {zone.name, zone.thread_index, zone.depth});
+
+        ++zone_total->call_count;
+        zone_total->total_time_ns += zone.end_ns - zone.start_ns;
+    }
+
+    std::sort(zone_totals.begin(), zone_totals.end(), [](const ZoneTotal &total_0, const ZoneTotal &total_1) {
+        if (total_0.thread_index != total_1.thread_index)
+            return total_0.thread_index < total_1.thread_index;
+        return total_0.total_time_ns > total_1.total_time_ns;
+    });
+
+    log_info("Profile zones of frame {} ({} GPU zones dropped):", s_frame_index, s_dropped_gpu_zone_count);
+    for (const ZoneTotal &zone_total : zone_totals)
+    {
+        log_info(
+            "  {} {:>{}}{}: {} calls, {:.3f} ms",
+            zone_total.thread_index == GPU_THREAD_INDEX ? std::string{"gpu"} : std::to_string(zone_total.thread_index),
+            "",
+            zone_total.depth * 2,
+            zone_total.name,
+            zone_total.call_count,
+            static_cast<double>(zone_total.total_time_ns) / 1'000'000.0
+        );
+    }
+}
+
+bool write_chrome_trace(std::span<const ProfileZone> zones, std::string_view file_path)
+{
+    std::ofstream file{std::string{file_path}, std::ios_base::trunc};
+    VBAIL_ERROR_IF(!file, false, "Chrome trace file opening failed: {}", file_path);
+
+    file << "{\"traceEvents\": [\n";
+    file << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << GPU_THREAD_INDEX;
+    file << ", \"args\": {\"name\": \"GPU\"}}";
+    for (const ProfileZone &zone : zones)
+    {
+        file << ",\n  ";
+        write_trace_event(file, zone);
+    }
+    file << "\n]}\n";
+
+    VBAIL_ERROR_IF(!file, false, "Chrome trace file writing failed: {}", file_path);
+    return true;
+}
+
+void update_profiling()
+{
+    ++s_frame_index;
+    read_gpu_queries(get_current_gpu_frame_queries());
+
+    if (s_dump_interval != 0 && s_frame_index % s_dump_interval == 0)
+        dump_profile_zones();
+}
+} // namespace Age::Core
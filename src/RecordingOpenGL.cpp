@@ -0,0 +1,335 @@
+#ifdef AGE_RECORDING_OGL
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "Logging.hpp"
+#include "OpenGL.hpp"
+#include "RecordingOpenGL.hpp"
+
+namespace Age::Gfx::OGL
+{
+namespace
+{
+// The OpenGL functions called by the engine, without their gl prefix
+#define AGE_RECORDED_GL_FUNCTIONS(X)                                                                                   \
+    X(ActiveTexture)                                                                                                   \
+    X(AttachShader)                                                                                                    \
+    X(BeginQuery)                                                                                                      \
+    X(BindBuffer)                                                                                                      \
+    X(BindBufferRange)                                                                                                 \
+    X(BindSampler)                                                                                                     \
+    X(BindTexture)                                                                                                     \
+    X(BindVertexArray)                                                                                                 \
+    X(BufferData)                                                                                                      \
+    X(BufferSubData)                                                                                                   \
+    X(Clear)                                                                                                           \
+    X(ClearColor)                                                                                                      \
+    X(ClearDepth)                                                                                                      \
+    X(CompileShader)                                                                                                   \
+    X(CompressedTexImage1D)                                                                                            \
+    X(CompressedTexImage2D)                                                                                            \
+    X(CompressedTexImage3D)                                                                                            \
+    X(CreateProgram)                                                                                                   \
+    X(CreateShader)                                                                                                    \
+    X(CullFace)                                                                                                        \
+    X(DeleteShader)                                                                                                    \
+    X(DepthFunc)                                                                                                       \
+    X(DepthMask)                                                                                                       \
+    X(DepthRange)                                                                                                      \
+    X(DetachShader)                                                                                                    \
+    X(Disable)                                                                                                         \
+    X(DrawArrays)                                                                                                      \
+    X(DrawArraysInstanced)                                                                                             \
+    X(DrawElementsBaseVertex)                                                                                          \
+    X(DrawElementsInstancedBaseVertex)                                                                                 \
+    X(Enable)                                                                                                          \
+    X(EndQuery)                                                                                                        \
+    X(EnableVertexAttribArray)                                                                                         \
+    X(FrontFace)                                                                                                       \
+    X(GenBuffers)                                                                                                      \
+    X(GenQueries)                                                                                                      \
+    X(GenSamplers)                                                                                                     \
+    X(GenTextures)                                                                                                     \
+    X(GenVertexArrays)                                                                                                 \
+    X(GetFloatv)                                                                                                       \
+    X(GetIntegerv)                                                                                                     \
+    X(GetProgramInfoLog)                                                                                               \
+    X(GetProgramiv)                                                                                                    \
+    X(GetQueryObjectiv)                                                                                                \
+    X(GetQueryObjectui64v)                                                                                             \
+    X(GetShaderInfoLog)                                                                                                \
+    X(GetShaderiv)                                                                                                     \
+    X(GetUniformBlockIndex)                                                                                            \
+    X(GetUniformLocation)                                                                                              \
+    X(LinkProgram)                                                                                                     \
+    X(MapBufferRange)                                                                                                  \
+    X(MultiDrawElementsBaseVertex)                                                                                     \
+    X(PixelStorei)                                                                                                     \
+    X(SamplerParameterf)                                                                                               \
+    X(SamplerParameterfv)                                                                                              \
+    X(SamplerParameteri)                                                                                               \
+    X(Scissor)                                                                                                         \
+    X(ShaderSource)                                                                                                    \
+    X(TexImage1D)                                                                                                      \
+    X(TexImage2D)                                                                                                      \
+    X(TexImage3D)                                                                                                      \
+    X(TexParameteri)                                                                                                   \
+    X(Uniform1f)                                                                                                       \
+    X(Uniform1i)                                                                                                       \
+    X(Uniform3fv)                                                                                                      \
+    X(Uniform4fv)                                                                                                      \
+    X(UniformBlockBinding)                                                                                             \
+    X(UniformMatrix3fv)                                                                                                \
+    X(UniformMatrix4fv)                                                                                                \
+    X(UnmapBuffer)                                                                                                     \
+    X(UseProgram)                                                                                                      \
+    X(VertexAttribPointer)                                                                                             \
+    X(Viewport)
+
+#define AGE_RECORDED_FUNCTION_ENUMERATOR(name) name,
+#define AGE_RECORDED_FUNCTION_NAME(name) "gl" #name,
+
+enum struct RecordedFunction : std::uint16_t
+{
+    AGE_RECORDED_GL_FUNCTIONS(AGE_RECORDED_FUNCTION_ENUMERATOR)
+};
+
+constexpr std::string_view s_recorded_function_names[] = {AGE_RECORDED_GL_FUNCTIONS(AGE_RECORDED_FUNCTION_NAME)};
+
+#undef AGE_RECORDED_FUNCTION_ENUMERATOR
+#undef AGE_RECORDED_FUNCTION_NAME
+
+constexpr std::size_t RECORDED_FUNCTION_COUNT{std::size(s_recorded_function_names)};
+
+using Clock = std::chrono::steady_clock;
+
+Clock::time_point s_start_time{};
+Clock::time_point s_last_call_time{};
+std::vector<RecordedCall> s_recorded_calls{};
+std::array<RecordedFunctionStats, RECORDED_FUNCTION_COUNT> s_recorded_function_stats{};
+
+GLuint s_next_object_name{1};
+GLint s_next_uniform_location{};
+GLuint s_next_uniform_block_index{};
+std::vector<std::byte> s_mapped_buffer{};
+
+std::uint64_t to_nanoseconds(Clock::duration duration)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+void record_call(RecordedFunction function)
+{
+    Clock::time_point time{Clock::now()};
+
+    RecordedFunctionStats &stats{s_recorded_function_stats[static_cast<std::size_t>(function)]};
+    ++stats.call_count;
+    stats.preceding_time_ns += to_nanoseconds(time - s_last_call_time);
+
+    s_recorded_calls.push_back({stats.function_name, to_nanoseconds(time - s_start_time)});
+    s_last_call_time = time;
+}
+
+// Functions without outputs only record their calls
+template <RecordedFunction FUNCTION, typename TFunction>
+struct RecordingStub;
+
+template <RecordedFunction FUNCTION, typename TReturn, typename... TArgs>
+struct RecordingStub<FUNCTION, TReturn(APIENTRY *)(TArgs...)>
+{
+    static TReturn APIENTRY call(TArgs...)
+    {
+        record_call(FUNCTION);
+        return TReturn();
+    }
+};
+
+template <RecordedFunction FUNCTION>
+void APIENTRY generate_object_names(GLsizei count, GLuint *names)
+{
+    record_call(FUNCTION);
+    for (GLsizei index{}; index < count; ++index)
+        names[index] = s_next_object_name++;
+}
+
+GLuint APIENTRY create_program()
+{
+    record_call(RecordedFunction::CreateProgram);
+    return s_next_object_name++;
+}
+
+GLuint APIENTRY create_shader(GLenum)
+{
+    record_call(RecordedFunction::CreateShader);
+    return s_next_object_name++;
+}
+
+void APIENTRY get_shader_parameter(GLuint, GLenum param_name, GLint *params)
+{
+    record_call(RecordedFunction::GetShaderiv);
+    *params = param_name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void APIENTRY get_program_parameter(GLuint, GLenum param_name, GLint *params)
+{
+    record_call(RecordedFunction::GetProgramiv);
+    *params = param_name == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+// Minimum values required by OpenGL 3.3, except for the usual uniform buffer offset alignment
+void APIENTRY get_integer(GLenum param_name, GLint *data)
+{
+    record_call(RecordedFunction::GetIntegerv);
+    switch (param_name)
+    {
+    case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+        *data = 36;
+        break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        *data = 256;
+        break;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        *data = 48;
+        break;
+    case GL_UNPACK_ALIGNMENT:
+        *data = 4;
+        break;
+    default:
+        *data = 0;
+        break;
+    }
+}
+
+void APIENTRY get_float(GLenum param_name, GLfloat *data)
+{
+    record_call(RecordedFunction::GetFloatv);
+    *data = param_name == GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT ? 16.0f : 0.0f;
+}
+
+GLint APIENTRY get_uniform_location(GLuint, const GLchar *)
+{
+    record_call(RecordedFunction::GetUniformLocation);
+    return s_next_uniform_location++;
+}
+
+GLuint APIENTRY get_uniform_block_index(GLuint, const GLchar *)
+{
+    record_call(RecordedFunction::GetUniformBlockIndex);
+    return s_next_uniform_block_index++;
+}
+
+// The written data is discarded
+void *APIENTRY map_buffer_range(GLenum, GLintptr, GLsizeiptr length, GLbitfield)
+{
+    record_call(RecordedFunction::MapBufferRange);
+    if (s_mapped_buffer.size() < static_cast<std::size_t>(length))
+        s_mapped_buffer.resize(static_cast<std::size_t>(length));
+    return s_mapped_buffer.data();
+}
+
+GLboolean APIENTRY unmap_buffer(GLenum)
+{
+    record_call(RecordedFunction::UnmapBuffer);
+    return GL_TRUE;
+}
+} // namespace
+
+bool load_recording_functions()
+{
+    for (std::size_t index{}; index < RECORDED_FUNCTION_COUNT; ++index)
+        s_recorded_function_stats[index].function_name = s_recorded_function_names[index];
+
+#define AGE_LOAD_RECORDING_STUB(name)                                                                                  \
+    glad_gl##name = &RecordingStub<RecordedFunction::name, decltype(glad_gl##name)>::call;
+    AGE_RECORDED_GL_FUNCTIONS(AGE_LOAD_RECORDING_STUB)
+#undef AGE_LOAD_RECORDING_STUB
+
+    glad_glGenBuffers = &generate_object_names<RecordedFunction::GenBuffers>;
+    glad_glGenQueries = &generate_object_names<RecordedFunction::GenQueries>;
+    glad_glGenSamplers = &generate_object_names<RecordedFunction::GenSamplers>;
+    glad_glGenTextures = &generate_object_names<RecordedFunction::GenTextures>;
+    glad_glGenVertexArrays = &generate_object_names<RecordedFunction::GenVertexArrays>;
+    glad_glCreateProgram = &create_program;
+    glad_glCreateShader = &create_shader;
+    glad_glGetShaderiv = &get_shader_parameter;
+    glad_glGetProgramiv = &get_program_parameter;
+    glad_glGetIntegerv = &get_integer;
+    glad_glGetFloatv = &get_float;
+    glad_glGetUniformLocation = &get_uniform_location;
+    glad_glGetUniformBlockIndex = &get_uniform_block_index;
+    glad_glMapBufferRange = &map_buffer_range;
+    glad_glUnmapBuffer = &unmap_buffer;
+
+    // No context backs the pointers, an OpenGL function left null would crash on its first call
+    bool are_functions_loaded{true};
+#define AGE_CHECK_RECORDING_STUB(name)                                                                                 \
+    if (glad_gl##name == nullptr)                                                                                      \
+    {                                                                                                                  \
+        Core::log_error("gl" #name " has no recording stub");                                                          \
+        are_functions_loaded = false;                                                                                  \
+    }
+    AGE_RECORDED_GL_FUNCTIONS(AGE_CHECK_RECORDING_STUB)
+#undef AGE_CHECK_RECORDING_STUB
+
+    s_recorded_calls.reserve(1U << 16);
+    s_start_time = Clock::now();
+    s_last_call_time = s_start_time;
+    return are_functions_loaded;
+}
+
+void clear_recorded_calls()
+{
+    s_recorded_calls.clear();
+    for (RecordedFunctionStats &stats : s_recorded_function_stats)
+    {
+        stats.call_count = 0;
+        stats.preceding_time_ns = 0;
+    }
+    s_last_call_time = Clock::now();
+}
+
+std::span<const RecordedCall> get_recorded_calls()
+{
+    return s_recorded_calls;
+}
+
+std::uint64_t get_recorded_call_count(std::string_view function_name)
+{
+    for (const RecordedFunctionStats &stats : s_recorded_function_stats)
+    {
+        if (stats.function_name == function_name)
+            return stats.call_count;
+    }
+    return 0;
+}
+
+std::vector<RecordedFunctionStats> get_recorded_function_stats()
+{
+    std::vector<RecordedFunctionStats> function_stats{};
+    for (const RecordedFunctionStats &stats : s_recorded_function_stats)
+    {
+        if (stats.call_count != 0)
+            function_stats.push_back(stats);
+    }
+    return function_stats;
+}
+
+void log_recorded_function_stats()
+{
+    Core::log_info("Recorded OpenGL calls: {}", s_recorded_calls.size());
+    for (const RecordedFunctionStats &stats : get_recorded_function_stats())
+    {
+        Core::log_info(
+            "  {}: {} calls, {:.3f} us preceding each call on average",
+            stats.function_name,
+            stats.call_count,
+            static_cast<double>(stats.preceding_time_ns) / stats.call_count / 1000.0
+        );
+    }
+}
+} // namespace Age::Gfx::OGL
+
+#endif
@@ -0,0 +1,214 @@
+#include "RenderCommands.hpp"
+#include "ErrorHandling.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+template <typename TCommand>
+TCommand read_command(const std::byte *&bytes)
+{
+    TCommand command;
+    std::memcpy(&command, bytes, sizeof(TCommand));
+    bytes += sizeof(TCommand);
+    return command;
+}
+
+UniformBlock &get_shader_uniform_block(Shader &shader, ShaderUniformBlockType block_type)
+{
+    switch (block_type)
+    {
+    case ShaderUniformBlockType::INSTANCE:
+        return shader.instance_block;
+    case ShaderUniformBlockType::DRAW:
+        return shader.draw_block;
+    default:
+        return shader.projection_block;
+    }
+}
+
+void execute_draw(const DrawRenderCommand &command)
+{
+    const DrawCommand &draw_command{command.draw_command};
+    if (command.instance_count != 0)
+    {
+        switch (draw_command.type)
+        {
+        case DrawCommandType::DRAW_ARRAYS:
+            OGL::draw_arrays_instanced(
+                draw_command.rendering_mode, draw_command.element_count, draw_command.offset, command.instance_count
+            );
+            break;
+        case DrawCommandType::DRAW_ELEMENTS:
+            OGL::draw_elements_instanced(
+                draw_command.rendering_mode,
+                draw_command.element_count,
+                draw_command.index_type,
+                draw_command.offset,
+                command.instance_count,
+                draw_command.base_vertex
+            );
+            break;
+        }
+        return;
+    }
+
+    switch (draw_command.type)
+    {
+    case DrawCommandType::DRAW_ARRAYS:
+        OGL::draw_arrays(draw_command.rendering_mode, draw_command.element_count, draw_command.offset);
+        break;
+    case DrawCommandType::DRAW_ELEMENTS:
+        OGL::draw_elements(
+            draw_command.rendering_mode,
+            draw_command.element_count,
+            draw_command.index_type,
+            draw_command.offset,
+            draw_command.base_vertex
+        );
+        break;
+    }
+}
+} // namespace
+
+void RenderCommandBuffer::record_mesh_draws(std::span<const DrawCommand> draw_commands, std::uint32_t instance_count)
+{
+    for (std::size_t index{}; index < draw_commands.size();)
+    {
+        const DrawCommand &first_draw_command{draw_commands[index]};
+        if (instance_count != 0 || first_draw_command.type != DrawCommandType::DRAW_ELEMENTS)
+        {
+            record(DrawRenderCommand{first_draw_command, instance_count});
+            ++index;
+            continue;
+        }
+
+        MultiDrawRenderCommand multi_draw_command{};
+        std::size_t command_offset{_last_multi_draw_offset + sizeof(RenderCommandType)};
+        bool is_extended{_last_multi_draw_offset != NO_MULTI_DRAW};
+        if (is_extended)
+        {
+            std::memcpy(&multi_draw_command, &_bytes[command_offset], sizeof(MultiDrawRenderCommand));
+            is_extended = multi_draw_command.rendering_mode == first_draw_command.rendering_mode &&
+                          multi_draw_command.index_type == first_draw_command.index_type;
+        }
+        if (!is_extended)
+        {
+            multi_draw_command = {
+                .rendering_mode = first_draw_command.rendering_mode,
+                .index_type = first_draw_command.index_type,
+                .first_draw_index = static_cast<std::uint32_t>(_multi_draw_element_counts.size())
+            };
+        }
+
+        for (; index < draw_commands.size(); ++index)
+        {
+            const DrawCommand &draw_command{draw_commands[index]};
+            if (draw_command.type != DrawCommandType::DRAW_ELEMENTS ||
+                draw_command.rendering_mode != multi_draw_command.rendering_mode ||
+                draw_command.index_type != multi_draw_command.index_type)
+                break;
+
+            _multi_draw_element_counts.push_back(static_cast<GLsizei>(draw_command.element_count));
+            _multi_draw_offsets.push_back(reinterpret_cast<const void *>(draw_command.offset));
+            _multi_draw_base_vertices.push_back(draw_command.base_vertex);
+            ++multi_draw_command.draw_count;
+        }
+
+        if (is_extended)
+            std::memcpy(&_bytes[command_offset], &multi_draw_command, sizeof(MultiDrawRenderCommand));
+        else
+        {
+            std::size_t offset{_bytes.size()};
+            record(multi_draw_command);
+            _last_multi_draw_offset = offset;
+        }
+    }
+}
+
+void RenderCommandBuffer::execute() const
+{
+    Shader *shader{};
+
+    const std::byte *bytes{_bytes.data()};
+    const std::byte *end{bytes + _bytes.size()};
+    while (bytes != end)
+    {
+        RenderCommandType type{read_command<RenderCommandType>(bytes)};
+        switch (type)
+        {
+        case RenderCommandType::USE_MATERIAL: {
+            auto command{read_command<UseMaterialCommand>(bytes)};
+            shader = &use_material(command.material_id).shader;
+            break;
+        }
+        case RenderCommandType::BIND_UNIFORM_BUFFER_RANGE: {
+            auto command{read_command<BindUniformBufferRangeCommand>(bytes)};
+            bind_uniform_buffer_range(
+                shader->shader_program,
+                get_shader_uniform_block(*shader, command.block_type),
+                command.uniform_buffer_range_id
+            );
+            break;
+        }
+        case RenderCommandType::BIND_STREAMED_UNIFORM_BUFFER_RANGE: {
+            auto command{read_command<BindStreamedUniformBufferRangeCommand>(bytes)};
+            bind_streamed_uniform_buffer_range(
+                shader->shader_program,
+                get_shader_uniform_block(*shader, command.block_type),
+                command.buffer_object,
+                command.offset,
+                command.size
+            );
+            break;
+        }
+        case RenderCommandType::SET_LW_MATRIX: {
+            auto command{read_command<SetLwMatrixCommand>(bytes)};
+            OGL::set_uniform(shader->lw_matrix, command.lw_matrix);
+            break;
+        }
+        case RenderCommandType::SET_LW_NORMAL_MATRIX: {
+            auto command{read_command<SetLwNormalMatrixCommand>(bytes)};
+            OGL::set_uniform(shader->lw_normal_matrix, command.lw_normal_matrix);
+            break;
+        }
+        case RenderCommandType::BIND_VERTEX_ARRAY: {
+            auto command{read_command<BindVertexArrayCommand>(bytes)};
+            OGL::bind_vertex_array_object(command.vertex_array_object);
+            break;
+        }
+        case RenderCommandType::DRAW:
+            execute_draw(read_command<DrawRenderCommand>(bytes));
+            break;
+        case RenderCommandType::MULTI_DRAW: {
+            auto command{read_command<MultiDrawRenderCommand>(bytes)};
+            std::uint32_t index{command.first_draw_index};
+            if (command.draw_count == 1)
+            {
+                OGL::draw_elements(
+                    command.rendering_mode,
+                    static_cast<std::uint32_t>(_multi_draw_element_counts[index]),
+                    command.index_type,
+                    reinterpret_cast<std::size_t>(_multi_draw_offsets[index]),
+                    _multi_draw_base_vertices[index]
+                );
+                break;
+            }
+
+            OGL::multi_draw_elements(
+                command.rendering_mode,
+                command.index_type,
+                &_multi_draw_element_counts[index],
+                &_multi_draw_offsets[index],
+                &_multi_draw_base_vertices[index],
+                command.draw_count
+            );
+            break;
+        }
+        default:
+            Core::log_error("Unknown render command type: {}", static_cast<unsigned int>(type));
+            return;
+        }
+    }
+}
+} // namespace Age::Gfx
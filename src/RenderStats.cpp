@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <array>
+
+#include "Logging.hpp"
+#include "RenderStats.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+constexpr std::size_t RENDER_STATS_HISTORY_SIZE{120};
+
+std::uint32_t s_log_interval{};
+
+std::uint64_t s_frame_index{};
+RenderStats s_last_frame_render_stats{};
+std::array<RenderStats, RENDER_STATS_HISTORY_SIZE> s_render_stats_history{};
+
+template <typename TCounter>
+void log_counter(std::string_view name, std::span<const RenderStats> stats, TCounter RenderStats::*counter)
+{
+    std::uint64_t total{};
+    std::uint64_t maximum{};
+    for (const RenderStats &frame_stats : stats)
+    {
+        total += frame_stats.*counter;
+        maximum = std::max<std::uint64_t>(maximum, frame_stats.*counter);
+    }
+    Core::log_info("  {}: {:.1f} average, {} maximum", name, static_cast<double>(total) / stats.size(), maximum);
+}
+} // namespace
+
+RenderStats g_render_stats{};
+
+void init_render_stats(const App::Definitions &definitions)
+{
+    s_log_interval = definitions.render_stats_log_interval;
+}
+
+const RenderStats &get_last_frame_render_stats()
+{
+    return s_last_frame_render_stats;
+}
+
+std::vector<RenderStats> get_render_stats_history()
+{
+    std::vector<RenderStats> history{};
+    std::uint64_t frame_count{std::min<std::uint64_t>(s_frame_index, RENDER_STATS_HISTORY_SIZE)};
+    history.reserve(frame_count);
+    for (std::uint64_t frame_index{s_frame_index - frame_count}; frame_index < s_frame_index; ++frame_index)
+        history.push_back(s_render_stats_history[frame_index % RENDER_STATS_HISTORY_SIZE]);
+    return history;
+}
+
+void log_render_stats(std::span<const RenderStats> stats)
+{
+    if (stats.empty())
+        return;
+
+    Core::log_info("Render stats of frames {} to {}:", stats.front().frame_index, stats.back().frame_index);
+    log_counter("draw calls", stats, &RenderStats::draw_call_count);
+    log_counter("instanced draw calls", stats, &RenderStats::instanced_draw_call_count);
+    log_counter("multi draw calls", stats, &RenderStats::multi_draw_call_count);
+    log_counter("multi drawn draws", stats, &RenderStats::multi_drawn_draw_count);
+    log_counter("instances", stats, &RenderStats::instance_count);
+    log_counter("vertices", stats, &RenderStats::vertex_count);
+    log_counter("triangles", stats, &RenderStats::triangle_count);
+    log_counter("material switches", stats, &RenderStats::material_switch_count);
+    log_counter("shader switches", stats, &RenderStats::shader_switch_count);
+    log_counter("vertex array binds", stats, &RenderStats::vertex_array_bind_count);
+    log_counter("texture binds", stats, &RenderStats::texture_bind_count);
+    log_counter("sampler binds", stats, &RenderStats::sampler_bind_count);
+    log_counter("uniform buffer binds", stats, &RenderStats::uniform_buffer_bind_count);
+    log_counter("uploaded bytes", stats, &RenderStats::uploaded_byte_count);
+
+    std::uint64_t issued_call_count{};
+    std::uint64_t filtered_call_count{};
+    for (const RenderStats &frame_stats : stats)
+    {
+        issued_call_count += frame_stats.state_call_counters.issued_call_count;
+        filtered_call_count += frame_stats.state_call_counters.filtered_call_count;
+    }
+    Core::log_info(
+        "  state calls: {:.1f} issued, {:.1f} filtered on average",
+        static_cast<double>(issued_call_count) / stats.size(),
+        static_cast<double>(filtered_call_count) / stats.size()
+    );
+}
+
+void update_render_stats()
+{
+    g_render_stats.frame_index = s_frame_index;
+    g_render_stats.state_call_counters = OGL::get_state_call_counters();
+    OGL::reset_state_call_counters();
+
+    s_last_frame_render_stats = g_render_stats;
+    s_render_stats_history[s_frame_index % RENDER_STATS_HISTORY_SIZE] = g_render_stats;
+    g_render_stats = {};
+
+    ++s_frame_index;
+
+    if (s_log_interval != 0 && s_frame_index % s_log_interval == 0)
+    {
+        std::vector<RenderStats> history{get_render_stats_history()};
+        std::size_t logged_frame_count{std::min<std::size_t>(s_log_interval, history.size())};
+        log_render_stats(std::span{history}.last(logged_frame_count));
+    }
+}
+} // namespace Age::Gfx
@@ -1,86 +1,837 @@
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cmath>
+#include <execution>
 #include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
 #include <tuple>
 #include <vector>
 
 #include "Camera.hpp"
 #include "Color.hpp"
 #include "ECS.hpp"
+#include "ErrorHandling.hpp"
 #include "Lighting.hpp"
+#include "OcclusionCulling.hpp"
 #include "OpenGL.hpp"
+#include "Profiling.hpp"
+#include "RadixSort.hpp"
+#include "RenderStats.hpp"
+#include "RenderCommands.hpp"
 #include "Rendering.hpp"
 #include "Texture.hpp"
 #include "Transformations.hpp"
+#include "UniformBlocks.hpp"
 #include "Viewport.hpp"
 
 namespace Age::Gfx
 {
 namespace
 {
+// Null in headless runs, where nothing is presented
 GLFWwindow *s_window{};
 
-void calc_local_to_view_matrix(
-    const Math::Matrix4 &wv_matrix, const Core::Transform &transform, LocalToViewMatrix &lv_matrix
-)
+constexpr unsigned int PASS_BIT_COUNT{4U};
+constexpr unsigned int MATERIAL_ID_BIT_COUNT{24U};
+constexpr unsigned int MESH_ID_BIT_COUNT{16U};
+constexpr unsigned int DEPTH_BIT_COUNT{19U};
+
+constexpr unsigned int PASS_SHIFT_COUNT{63U - PASS_BIT_COUNT + 1U};
+constexpr unsigned int TRANSLUCENT_SHIFT_COUNT{PASS_SHIFT_COUNT - 1U};
+constexpr DrawCallSortKey TRANSLUCENT_BIT{DrawCallSortKey{1} << TRANSLUCENT_SHIFT_COUNT};
+
+constexpr unsigned int OPAQUE_MATERIAL_ID_SHIFT_COUNT{TRANSLUCENT_SHIFT_COUNT - MATERIAL_ID_BIT_COUNT};
+constexpr unsigned int OPAQUE_MESH_ID_SHIFT_COUNT{OPAQUE_MATERIAL_ID_SHIFT_COUNT - MESH_ID_BIT_COUNT};
+
+constexpr unsigned int TRANSLUCENT_DEPTH_SHIFT_COUNT{TRANSLUCENT_SHIFT_COUNT - DEPTH_BIT_COUNT};
+constexpr unsigned int TRANSLUCENT_MATERIAL_ID_SHIFT_COUNT{TRANSLUCENT_DEPTH_SHIFT_COUNT - MATERIAL_ID_BIT_COUNT};
+constexpr unsigned int TRANSLUCENT_MESH_ID_SHIFT_COUNT{0U};
+
+static_assert(OPAQUE_MESH_ID_SHIFT_COUNT == DEPTH_BIT_COUNT);
+static_assert(TRANSLUCENT_MATERIAL_ID_SHIFT_COUNT == MESH_ID_BIT_COUNT);
+
+constexpr DrawCallSortKey DEPTH_MASK{(DrawCallSortKey{1} << DEPTH_BIT_COUNT) - 1};
+
+constexpr DrawCallSortKey make_sort_key(std::uint8_t pass, bool is_translucent, MaterialId material_id, MeshId mesh_id)
+{
+    DrawCallSortKey sort_key{DrawCallSortKey{pass} << PASS_SHIFT_COUNT};
+    if (is_translucent)
+    {
+        sort_key |= TRANSLUCENT_BIT;
+        sort_key |= DrawCallSortKey{material_id} << TRANSLUCENT_MATERIAL_ID_SHIFT_COUNT;
+        sort_key |= DrawCallSortKey{mesh_id} << TRANSLUCENT_MESH_ID_SHIFT_COUNT;
+    }
+    else
+    {
+        sort_key |= DrawCallSortKey{material_id} << OPAQUE_MATERIAL_ID_SHIFT_COUNT;
+        sort_key |= DrawCallSortKey{mesh_id} << OPAQUE_MESH_ID_SHIFT_COUNT;
+    }
+    return sort_key;
+}
+
+// The bit pattern of positive floats grows with their value,
+// so the exponent and the high mantissa bits give a logarithmic depth quantization
+std::uint32_t quantize_depth(float view_distance)
+{
+    return std::bit_cast<std::uint32_t>(std::max(view_distance, 0.0f)) >> (31U - DEPTH_BIT_COUNT);
+}
+
+// Only translucent keys hold a depth, opaque ones keep their state order
+DrawCallSortKey set_sort_key_depth(DrawCallSortKey sort_key, std::uint32_t depth)
 {
-    lv_matrix.matrix = wv_matrix * Core::transform_matrix(transform);
+    sort_key &= ~(DEPTH_MASK << TRANSLUCENT_DEPTH_SHIFT_COUNT);
+    return sort_key | (~DrawCallSortKey{depth} & DEPTH_MASK) << TRANSLUCENT_DEPTH_SHIFT_COUNT;
 }
 
-void calc_local_to_view_normal_matrix(const LocalToViewMatrix &lv_matrix, LocalToViewNormalMatrix &lv_normal_matrix)
+bool is_draw_call_key_less(const DrawCallKey &key_0, const DrawCallKey &key_1)
 {
-    lv_normal_matrix.matrix = Math::Matrix3{lv_matrix.matrix}.invert().transpose();
+    return key_0.sort_key < key_1.sort_key || (key_0.sort_key == key_1.sort_key && key_0.index < key_1.index);
 }
 
-constexpr unsigned int MATERIAL_ID_SHIFT_COUNT{16U};
-constexpr unsigned int MESH_ID_SHIFT_COUNT{0U};
+bool is_draw_call_key_equal(const DrawCallKey &key_0, const DrawCallKey &key_1)
+{
+    return key_0.sort_key == key_1.sort_key && key_0.index == key_1.index;
+}
 
 std::vector<DrawCall> s_draw_calls{};
+std::vector<DrawCallIndex> s_free_draw_call_indexes{};
+BoundingVolumeHierarchy s_scene_bvh{};
+OcclusionBuffer s_occlusion_buffer{};
+
+// The keys of the active draw calls in state order,
+// the changes are gathered during the frame and merged into the list before rendering
+std::vector<DrawCallKey> s_draw_list{};
+std::vector<DrawCallKey> s_draw_list_buffer{};
+std::vector<DrawCallKey> s_added_draw_call_keys{};
+std::vector<DrawCallKey> s_removed_draw_call_keys{};
+
+constexpr std::uint32_t INVALID_DRAW_LIST_RANK{std::numeric_limits<std::uint32_t>::max()};
+
+// Position of the key of each draw call in the draw list, computed again on the frames the list changes
+std::vector<std::uint32_t> s_draw_call_ranks{};
+
+// Unordered draw call indexes, the position of each index is kept so it is removed in constant time
+class DrawCallIndexSet
+{
+    static constexpr std::uint32_t INVALID_POSITION{std::numeric_limits<std::uint32_t>::max()};
+
+    std::vector<DrawCallIndex> _indexes{};
+    std::vector<std::uint32_t> _positions{};
+
+  public:
+    void reserve(std::size_t count)
+    {
+        _indexes.reserve(count);
+        _positions.reserve(count);
+    }
+
+    void insert(DrawCallIndex draw_call_index)
+    {
+        if (draw_call_index >= _positions.size())
+            _positions.resize(draw_call_index + 1, INVALID_POSITION);
+        if (_positions[draw_call_index] != INVALID_POSITION)
+            return;
+
+        _positions[draw_call_index] = static_cast<std::uint32_t>(_indexes.size());
+        _indexes.push_back(draw_call_index);
+    }
+
+    void erase(DrawCallIndex draw_call_index)
+    {
+        if (draw_call_index >= _positions.size() || _positions[draw_call_index] == INVALID_POSITION)
+            return;
+
+        std::uint32_t position{_positions[draw_call_index]};
+        DrawCallIndex last_draw_call_index{_indexes.back()};
+        _indexes[position] = last_draw_call_index;
+        _positions[last_draw_call_index] = position;
+        _indexes.pop_back();
+        _positions[draw_call_index] = INVALID_POSITION;
+    }
+
+    void clear()
+    {
+        for (DrawCallIndex draw_call_index : _indexes)
+            _positions[draw_call_index] = INVALID_POSITION;
+        _indexes.clear();
+    }
+
+    std::span<const DrawCallIndex> indexes() const
+    {
+        return _indexes;
+    }
+};
+
+// Only these draw calls are updated in a frame, so the cost of a frame follows the moving renderers
+DrawCallIndexSet s_dynamic_draw_call_indexes{};
+DrawCallIndexSet s_moved_draw_call_indexes{};
+std::vector<DrawCallIndex> s_updated_draw_call_indexes{};
+// Draw calls without a BVH item, drawn by all the cameras
+DrawCallIndexSet s_unbounded_draw_call_indexes{};
+
+// Copied from the components of the updated draw calls, indexed by draw call index
+struct ExtractedDrawCall
+{
+    Math::Matrix4 lw_matrix{1.0f};
+    Math::Matrix3 lw_normal_matrix{1.0f};
+    Math::Vector3 bounds_center{};
+    float bounds_radius{-1.0f};
+};
+
+// Built per camera in draw order, so the submission reads it linearly
+struct RenderItem
+{
+    Math::Matrix4 lw_matrix{};
+    Math::Matrix3 lw_normal_matrix{};
+    MaterialId material_id{};
+    MeshId mesh_id{};
+    std::uint8_t options{};
+};
+
+std::vector<ExtractedDrawCall> s_extracted_draw_calls{};
+
+std::vector<std::uint32_t> s_visible_draw_call_indexes{};
+std::vector<std::uint32_t> s_visible_draw_call_ranks{};
+std::vector<std::uint32_t> s_visible_draw_call_rank_buffer{};
+// The keys of the draw calls visible from the current camera
 std::vector<DrawCallKey> s_draw_call_keys{};
+std::vector<DrawCallKey> s_draw_call_key_buffer{};
+std::vector<RenderItem> s_render_items{};
+
+// Render items drawn by a single draw call, the ones using draw data own a range of the draw data buffer
+struct DrawGroup
+{
+    std::uint32_t first_item_index{};
+    std::uint32_t instance_count{};
+    std::size_t draw_data_offset{};
+    bool uses_draw_data{};
+};
+
+constexpr std::size_t INSTANCE_BLOCK_SIZE{sizeof(InstanceData) * MAX_INSTANCE_COUNT};
+constexpr std::size_t DRAW_BLOCK_SIZE{sizeof(InstanceData)};
+constexpr std::size_t DRAW_DATA_BUFFER_SIZE{1U << 23};
+
+StreamingUniformBuffer s_draw_data_buffer{};
+std::size_t s_draw_data_buffer_offset{};
+std::vector<std::byte> s_draw_data{};
+std::vector<DrawGroup> s_draw_groups{};
+
+// The draw groups are split in contiguous slices recorded in parallel, then executed in order
+constexpr std::size_t RENDER_COMMAND_BUFFER_COUNT{8};
+constexpr std::size_t MIN_RECORDED_DRAW_GROUP_COUNT{64};
+
+std::array<RenderCommandBuffer, RENDER_COMMAND_BUFFER_COUNT> s_render_command_buffers{};
+std::array<std::uint32_t, RENDER_COMMAND_BUFFER_COUNT> s_render_command_buffer_indexes{};
+
+DrawCallSortKey make_renderer_sort_key(const Renderer &renderer, MaterialId material_id, MeshId mesh_id)
+{
+    LOG_ERROR_IF(
+        material_id >= 1U << MATERIAL_ID_BIT_COUNT, "Material id {} exceeds the draw call sort key range", material_id
+    );
+    LOG_ERROR_IF(
+        renderer.render_pass >= 1U << PASS_BIT_COUNT,
+        "Render pass {} exceeds the draw call sort key range",
+        renderer.render_pass
+    );
+
+    return make_sort_key(renderer.render_pass, renderer.is_translucent, material_id, mesh_id);
+}
+
+void add_to_draw_list(const DrawCallKey &draw_call_key)
+{
+    s_added_draw_call_keys.push_back(draw_call_key);
+}
+
+void remove_from_draw_list(const DrawCallKey &draw_call_key)
+{
+    auto iterator{std::find_if(
+        s_added_draw_call_keys.begin(),
+        s_added_draw_call_keys.end(),
+        [&](const DrawCallKey &added_key) { return is_draw_call_key_equal(added_key, draw_call_key); }
+    )};
+    if (iterator != s_added_draw_call_keys.end())
+    {
+        *iterator = s_added_draw_call_keys.back();
+        s_added_draw_call_keys.pop_back();
+    }
+    else
+        s_removed_draw_call_keys.push_back(draw_call_key);
+}
+
+// Linear in the size of the list, only on frames where draw calls were added or removed
+void update_draw_list()
+{
+    if (s_removed_draw_call_keys.empty() && s_added_draw_call_keys.empty())
+        return;
+
+    if (!s_removed_draw_call_keys.empty())
+    {
+        std::sort(s_removed_draw_call_keys.begin(), s_removed_draw_call_keys.end(), is_draw_call_key_less);
+
+        std::size_t kept_count{};
+        std::size_t removed_index{};
+        for (const DrawCallKey &draw_call_key : s_draw_list)
+        {
+            while (removed_index < s_removed_draw_call_keys.size() &&
+                   is_draw_call_key_less(s_removed_draw_call_keys[removed_index], draw_call_key))
+                ++removed_index;
+
+            if (removed_index < s_removed_draw_call_keys.size() &&
+                is_draw_call_key_equal(s_removed_draw_call_keys[removed_index], draw_call_key))
+                continue;
+
+            s_draw_list[kept_count++] = draw_call_key;
+        }
+        s_draw_list.resize(kept_count);
+
+        for (const DrawCallKey &draw_call_key : s_removed_draw_call_keys)
+            s_draw_call_ranks[draw_call_key.index] = INVALID_DRAW_LIST_RANK;
+        s_removed_draw_call_keys.clear();
+    }
+
+    if (!s_added_draw_call_keys.empty())
+    {
+        std::sort(s_added_draw_call_keys.begin(), s_added_draw_call_keys.end(), is_draw_call_key_less);
 
-GLuint s_bound_vao{};
+        s_draw_list_buffer.resize(s_draw_list.size() + s_added_draw_call_keys.size());
+        std::merge(
+            s_draw_list.begin(),
+            s_draw_list.end(),
+            s_added_draw_call_keys.begin(),
+            s_added_draw_call_keys.end(),
+            s_draw_list_buffer.begin(),
+            is_draw_call_key_less
+        );
+        s_draw_list.swap(s_draw_list_buffer);
+        s_added_draw_call_keys.clear();
+    }
+
+    for (std::size_t rank{}; rank < s_draw_list.size(); ++rank)
+        s_draw_call_ranks[s_draw_list[rank].index] = static_cast<std::uint32_t>(rank);
+}
+
+// Static draw calls are only updated on the frame following their move
+void mark_draw_call_moved(DrawCallIndex draw_call_index)
+{
+    const DrawCall &draw_call{s_draw_calls[draw_call_index]};
+    if (draw_call.has_transform && (draw_call.options & WITH_STATIC_TRANSFORM))
+        s_moved_draw_call_indexes.insert(draw_call_index);
+}
 
 void init_renderer(
-    Renderer &renderer,
-    const Math::Matrix4 *lv_matrix,
-    const Math::Matrix3 *lv_normal_matrix,
-    MaterialId material_id,
-    MeshId mesh_id
+    Core::EntityId entity_id, Renderer &renderer, unsigned int options, MaterialId material_id, MeshId mesh_id
 )
 {
-    s_draw_calls.emplace_back(lv_matrix, lv_normal_matrix, material_id, mesh_id);
+    DrawCallIndex draw_call_index{};
+    if (s_free_draw_call_indexes.empty())
+    {
+        draw_call_index = static_cast<DrawCallIndex>(s_draw_calls.size());
+        s_draw_calls.emplace_back();
+        s_extracted_draw_calls.emplace_back();
+        s_draw_call_ranks.push_back(INVALID_DRAW_LIST_RANK);
+    }
+    else
+    {
+        draw_call_index = s_free_draw_call_indexes.back();
+        s_free_draw_call_indexes.pop_back();
+    }
+
+    bool has_transform{Core::has_entity_component<Core::Transform>(entity_id)};
+    bool has_world_bounds{has_transform && Core::has_entity_component<WorldBounds>(entity_id)};
+    LOG_ERROR_IF(
+        (options & WITH_WORLD_BOUNDS) && !has_world_bounds,
+        "Renderer of entity {} needs a Transform and a WorldBounds for its world bounds",
+        entity_id
+    );
+    if (!has_world_bounds)
+        options &= ~WITH_WORLD_BOUNDS;
+
+    s_draw_calls[draw_call_index] = {
+        .entity_id = entity_id,
+        .material_id = material_id,
+        .mesh_id = mesh_id,
+        .options = static_cast<std::uint8_t>(options),
+        .has_transform = has_transform
+    };
+    s_extracted_draw_calls[draw_call_index] = {};
+
+    if (has_transform && !(options & WITH_STATIC_TRANSFORM))
+        s_dynamic_draw_call_indexes.insert(draw_call_index);
+    else
+        mark_draw_call_moved(draw_call_index);
+    s_unbounded_draw_call_indexes.insert(draw_call_index);
 
     renderer.draw_call_key = {
-        .index = static_cast<DrawCallIndex>(s_draw_calls.size() - 1),
-        .sort_key = material_id << MATERIAL_ID_SHIFT_COUNT | mesh_id << MESH_ID_SHIFT_COUNT
+        .index = draw_call_index, .sort_key = make_renderer_sort_key(renderer, material_id, mesh_id)
+    };
+    if (renderer.is_active)
+        add_to_draw_list(renderer.draw_call_key);
+}
+
+void set_draw_call_state(Renderer &renderer, MaterialId material_id, MeshId mesh_id)
+{
+    DrawCall &draw_call{s_draw_calls[renderer.draw_call_key.index]};
+    draw_call.material_id = material_id;
+    draw_call.mesh_id = mesh_id;
+
+    DrawCallKey draw_call_key{
+        .index = renderer.draw_call_key.index, .sort_key = make_renderer_sort_key(renderer, material_id, mesh_id)
     };
+    if (renderer.is_active)
+    {
+        remove_from_draw_list(renderer.draw_call_key);
+        add_to_draw_list(draw_call_key);
+    }
+    renderer.draw_call_key = draw_call_key;
 }
 
-void enqueue_draw_calls(const Renderer &renderer)
+void release_draw_call(Renderer &renderer)
 {
+    if (renderer.draw_call_key.index == INVALID_DRAW_CALL_INDEX)
+        return;
+
     if (renderer.is_active)
-        s_draw_call_keys.emplace_back(renderer.draw_call_key);
+        remove_from_draw_list(renderer.draw_call_key);
+
+    DrawCall &draw_call{s_draw_calls[renderer.draw_call_key.index]};
+    if (draw_call.bvh_item_id != INVALID_BVH_ITEM_ID)
+        s_scene_bvh.remove_item(draw_call.bvh_item_id);
+    draw_call = {};
+
+    s_dynamic_draw_call_indexes.erase(renderer.draw_call_key.index);
+    s_moved_draw_call_indexes.erase(renderer.draw_call_key.index);
+    s_unbounded_draw_call_indexes.erase(renderer.draw_call_key.index);
+
+    s_free_draw_call_indexes.push_back(renderer.draw_call_key.index);
+    renderer.draw_call_key = {};
+}
+
+// Each draw call writes its own elements and components so the draw calls are updated in parallel,
+// the matrices are computed once per frame whatever the number of cameras
+void update_draw_call(DrawCallIndex draw_call_index)
+{
+    const DrawCall &draw_call{s_draw_calls[draw_call_index]};
+    ExtractedDrawCall &extracted_draw_call{s_extracted_draw_calls[draw_call_index]};
+    if (draw_call.options & WITH_WORLD_BOUNDS)
+    {
+        auto [transform, mesh, world_bounds] =
+            Core::get_entity_components<const Core::Transform, const MeshRef, WorldBounds>(draw_call.entity_id);
+        update_world_bounds(transform, mesh, world_bounds);
+        extracted_draw_call.bounds_center = world_bounds.center;
+        extracted_draw_call.bounds_radius = world_bounds.radius;
+        extracted_draw_call.lw_matrix = Core::transform_matrix(transform);
+    }
+    else
+    {
+        extracted_draw_call.lw_matrix =
+            Core::transform_matrix(Core::get_entity_component<const Core::Transform>(draw_call.entity_id));
+    }
+
+    if (draw_call.options & WITH_LW_NORMAL_MATRIX)
+        extracted_draw_call.lw_normal_matrix = Math::Matrix3{extracted_draw_call.lw_matrix}.invert().transpose();
+}
+
+void update_scene_bvh_item(DrawCallIndex draw_call_index)
+{
+    DrawCall &draw_call{s_draw_calls[draw_call_index]};
+    if ((draw_call.options & WITH_WORLD_BOUNDS) == 0)
+        return;
+
+    const ExtractedDrawCall &extracted_draw_call{s_extracted_draw_calls[draw_call_index]};
+    if (extracted_draw_call.bounds_radius < 0.0f)
+    {
+        if (draw_call.bvh_item_id != INVALID_BVH_ITEM_ID)
+        {
+            s_scene_bvh.remove_item(draw_call.bvh_item_id);
+            draw_call.bvh_item_id = INVALID_BVH_ITEM_ID;
+            s_unbounded_draw_call_indexes.insert(draw_call_index);
+        }
+    }
+    else if (draw_call.bvh_item_id == INVALID_BVH_ITEM_ID)
+    {
+        draw_call.bvh_item_id = s_scene_bvh.insert_item(
+            extracted_draw_call.bounds_center, extracted_draw_call.bounds_radius, draw_call_index
+        );
+        s_unbounded_draw_call_indexes.erase(draw_call_index);
+    }
+    else
+    {
+        s_scene_bvh.move_item(
+            draw_call.bvh_item_id, extracted_draw_call.bounds_center, extracted_draw_call.bounds_radius
+        );
+    }
+}
+
+// The dynamic draw calls and the static ones moved since the last frame, the others keep their data
+void update_draw_calls()
+{
+    std::span<const DrawCallIndex> dynamic_draw_call_indexes{s_dynamic_draw_call_indexes.indexes()};
+    std::span<const DrawCallIndex> moved_draw_call_indexes{s_moved_draw_call_indexes.indexes()};
+    s_updated_draw_call_indexes.assign(dynamic_draw_call_indexes.begin(), dynamic_draw_call_indexes.end());
+    s_updated_draw_call_indexes.insert(
+        s_updated_draw_call_indexes.end(), moved_draw_call_indexes.begin(), moved_draw_call_indexes.end()
+    );
+    s_moved_draw_call_indexes.clear();
+
+    std::for_each(
+        std::execution::par,
+        s_updated_draw_call_indexes.begin(),
+        s_updated_draw_call_indexes.end(),
+        update_draw_call
+    );
+
+    for (DrawCallIndex draw_call_index : s_updated_draw_call_indexes)
+        update_scene_bvh_item(draw_call_index);
+}
+
+void rasterize_occluder(const Core::Transform &transform, const MeshRef &mesh, const Occluder &occluder)
+{
+    if (!occluder.is_active)
+        return;
+
+    const OccluderMesh *occluder_mesh{get_occluder_mesh(mesh.mesh_id)};
+    if (occluder_mesh != nullptr)
+        s_occlusion_buffer.add_occluder(Core::transform_matrix(transform), *occluder_mesh);
 }
 
-void sort_draw_calls()
+void cull_occluded_draw_calls(const Math::Matrix4 &wc_matrix)
 {
-    s_draw_call_keys.clear();
-    Core::process_components(enqueue_draw_calls);
-    std::sort(s_draw_call_keys.begin(), s_draw_call_keys.end(), [](const DrawCallKey &lhs, const DrawCallKey &rhs) {
-        return lhs.sort_key < rhs.sort_key;
+    s_occlusion_buffer.begin(wc_matrix);
+    Core::process_components(rasterize_occluder);
+    if (s_occlusion_buffer.triangle_count() == 0)
+        return;
+
+    s_occlusion_buffer.rasterize();
+    std::erase_if(s_visible_draw_call_indexes, [](std::uint32_t draw_call_index) {
+        const ExtractedDrawCall &extracted_draw_call{s_extracted_draw_calls[draw_call_index]};
+        return s_occlusion_buffer.is_sphere_occluded(
+            extracted_draw_call.bounds_center, extracted_draw_call.bounds_radius
+        );
     });
 }
 
+// The histograms outweigh the sort of short ranges
+constexpr std::size_t MIN_RADIX_SORT_KEY_COUNT{256};
+
+// Linear in the number of visible draw calls, the ranks give back their keys in list order so they stay sorted by state
+void cull_draw_calls(const Math::Matrix4 &wc_matrix)
+{
+    s_visible_draw_call_indexes.clear();
+    s_scene_bvh.query_frustum(extract_frustum(wc_matrix), s_visible_draw_call_indexes);
+    cull_occluded_draw_calls(wc_matrix);
+
+    // Inactive renderers stay in the BVH but are not in the draw list
+    s_visible_draw_call_ranks.clear();
+    for (std::span<const DrawCallIndex> draw_call_indexes :
+         {std::span<const DrawCallIndex>{s_visible_draw_call_indexes}, s_unbounded_draw_call_indexes.indexes()})
+    {
+        for (DrawCallIndex draw_call_index : draw_call_indexes)
+        {
+            std::uint32_t rank{s_draw_call_ranks[draw_call_index]};
+            if (rank != INVALID_DRAW_LIST_RANK)
+                s_visible_draw_call_ranks.push_back(rank);
+        }
+    }
+
+    if (s_visible_draw_call_ranks.size() < MIN_RADIX_SORT_KEY_COUNT)
+        std::sort(s_visible_draw_call_ranks.begin(), s_visible_draw_call_ranks.end());
+    else
+    {
+        s_visible_draw_call_rank_buffer.resize(s_visible_draw_call_ranks.size());
+        Util::radix_sort(
+            std::span<std::uint32_t>{s_visible_draw_call_ranks},
+            std::span<std::uint32_t>{s_visible_draw_call_rank_buffer},
+            0,
+            [](std::uint32_t rank) { return std::uint64_t{rank}; }
+        );
+    }
+
+    s_draw_call_keys.resize(s_visible_draw_call_ranks.size());
+    for (std::size_t key_index{}; key_index < s_visible_draw_call_ranks.size(); ++key_index)
+        s_draw_call_keys[key_index] = s_draw_list[s_visible_draw_call_ranks[key_index]];
+}
+
+void sort_draw_call_keys(std::span<DrawCallKey> keys)
+{
+    if (keys.size() < MIN_RADIX_SORT_KEY_COUNT)
+    {
+        std::sort(keys.begin(), keys.end(), is_draw_call_key_less);
+        return;
+    }
+
+    // The keys come in state order, which is the order of their bits below the depth,
+    // so the stable sort only has to go through the depth and the bits above it.
+    // That is two scatter passes over the keys, measured by benchmarks/DrawCallSortBenchmark.cpp
+    // at about 0.09 ms for 10k keys and 1.1 to 1.4 ms for 100k keys, against 0.7 ms and 9 to 10 ms for std::sort
+    s_draw_call_key_buffer.resize(keys.size());
+    Util::radix_sort(
+        keys,
+        std::span<DrawCallKey>{s_draw_call_key_buffer},
+        TRANSLUCENT_DEPTH_SHIFT_COUNT,
+        [](const DrawCallKey &draw_call_key) { return draw_call_key.sort_key; }
+    );
+}
+
+float get_view_distance(const Math::Matrix4 &wv_matrix, const ExtractedDrawCall &extracted_draw_call)
+{
+    const Math::Vector4 &position{extracted_draw_call.lw_matrix[3]};
+    return -(wv_matrix[0].z * position.x + wv_matrix[1].z * position.y + wv_matrix[2].z * position.z + wv_matrix[3].z);
+}
+
+// The keys come in state order, the translucent keys following the opaque ones of their pass,
+// so only the ranges of translucent keys are sorted by depth
+void sort_draw_calls(const Math::Matrix4 &wv_matrix)
+{
+    for (std::size_t key_index{}; key_index < s_draw_call_keys.size();)
+    {
+        if ((s_draw_call_keys[key_index].sort_key & TRANSLUCENT_BIT) == 0)
+        {
+            ++key_index;
+            continue;
+        }
+
+        std::size_t end_key_index{key_index};
+        for (; end_key_index < s_draw_call_keys.size(); ++end_key_index)
+        {
+            DrawCallKey &draw_call_key{s_draw_call_keys[end_key_index]};
+            if ((draw_call_key.sort_key & TRANSLUCENT_BIT) == 0)
+                break;
+
+            float view_distance{get_view_distance(wv_matrix, s_extracted_draw_calls[draw_call_key.index])};
+            draw_call_key.sort_key = set_sort_key_depth(draw_call_key.sort_key, quantize_depth(view_distance));
+        }
+
+        sort_draw_call_keys({s_draw_call_keys.begin() + key_index, s_draw_call_keys.begin() + end_key_index});
+        key_index = end_key_index;
+    }
+}
+
+void build_render_items()
+{
+    s_render_items.resize(s_draw_call_keys.size());
+    for (std::size_t key_index{}; key_index < s_draw_call_keys.size(); ++key_index)
+    {
+        DrawCallIndex draw_call_index{s_draw_call_keys[key_index].index};
+        const DrawCall &draw_call{s_draw_calls[draw_call_index]};
+
+        RenderItem &render_item{s_render_items[key_index]};
+        render_item.material_id = draw_call.material_id;
+        render_item.mesh_id = draw_call.mesh_id;
+        render_item.options = draw_call.options;
+        const ExtractedDrawCall &extracted_draw_call{s_extracted_draw_calls[draw_call_index]};
+        if (draw_call.options & WITH_LW_MATRIX)
+            render_item.lw_matrix = extracted_draw_call.lw_matrix;
+        if (draw_call.options & WITH_LW_NORMAL_MATRIX)
+            render_item.lw_normal_matrix = extracted_draw_call.lw_normal_matrix;
+    }
+}
+
+bool uses_draw_data(const RenderItem &render_item)
+{
+    const Shader &shader{get_material(render_item.material_id).shader};
+    return is_uniform_block_defined(shader.instance_block) || is_uniform_block_defined(shader.draw_block);
+}
+
+// Consecutive draw calls sharing their material and mesh are drawn as instances of a single draw call
+std::uint32_t get_instance_count(std::size_t first_key_index)
+{
+    const RenderItem &first_render_item{s_render_items[first_key_index]};
+    std::size_t max_key_index{std::min(first_key_index + MAX_INSTANCE_COUNT, s_render_items.size())};
+
+    std::size_t key_index{first_key_index + 1};
+    for (; key_index < max_key_index; ++key_index)
+    {
+        const RenderItem &render_item{s_render_items[key_index]};
+        if (render_item.material_id != first_render_item.material_id ||
+            render_item.mesh_id != first_render_item.mesh_id)
+            break;
+    }
+    return static_cast<std::uint32_t>(key_index - first_key_index);
+}
+
+void write_instance_data(const RenderItem &render_item, InstanceData &instance_data)
+{
+    if (render_item.options & WITH_LW_MATRIX)
+        instance_data.lw_matrix = render_item.lw_matrix;
+    if (render_item.options & WITH_LW_NORMAL_MATRIX)
+    {
+        for (std::size_t column{}; column < 3; ++column)
+            instance_data.lw_normal_matrix[column] = Math::Vector4{render_item.lw_normal_matrix[column], 0.0f};
+    }
+}
+
+// Groups the render items of the camera by draw call, writes the per draw data of the groups
+// using a DrawBlock or an InstanceBlock and uploads it at once, each draw call then binds its own range of the buffer
+void stream_draw_data()
+{
+    s_draw_data.clear();
+    s_draw_groups.clear();
+
+    std::size_t offset_alignment{get_uniform_buffer_offset_alignment()};
+    std::size_t last_block_end{};
+    for (std::size_t key_index{}; key_index < s_render_items.size();)
+    {
+        const RenderItem &render_item{s_render_items[key_index]};
+        if (!uses_draw_data(render_item))
+        {
+            s_draw_groups.push_back({.first_item_index = static_cast<std::uint32_t>(key_index), .instance_count = 1});
+            ++key_index;
+            continue;
+        }
+
+        bool is_instanced{is_uniform_block_defined(get_material(render_item.material_id).shader.instance_block)};
+        std::uint32_t instance_count{is_instanced ? get_instance_count(key_index) : 1};
+        std::size_t offset{(s_draw_data.size() + offset_alignment - 1) / offset_alignment * offset_alignment};
+        s_draw_data.resize(offset + instance_count * sizeof(InstanceData));
+
+        InstanceData *instances{reinterpret_cast<InstanceData *>(&s_draw_data[offset])};
+        for (std::uint32_t index{}; index < instance_count; ++index)
+        {
+            new (&instances[index]) InstanceData{};
+            write_instance_data(s_render_items[key_index + index], instances[index]);
+        }
+
+        s_draw_groups.push_back({
+            .first_item_index = static_cast<std::uint32_t>(key_index),
+            .instance_count = instance_count,
+            .draw_data_offset = offset,
+            .uses_draw_data = true
+        });
+        last_block_end = offset + (is_instanced ? INSTANCE_BLOCK_SIZE : DRAW_BLOCK_SIZE);
+        key_index += instance_count;
+    }
+
+    if (last_block_end == 0)
+        return;
+
+    // Whole blocks are bound so the data extends past the last range
+    s_draw_data.resize(std::max(s_draw_data.size(), last_block_end));
+
+    s_draw_data_buffer_offset = s_draw_data_buffer.write(s_draw_data.data(), s_draw_data.size());
+}
+
+void record_render_commands(
+    std::span<const DrawGroup> draw_groups,
+    UniformBufferRangeId projection_buffer_range_id,
+    RenderCommandBuffer &command_buffer
+)
+{
+    command_buffer.clear();
+
+    MaterialId used_material_id{};
+    GLuint bound_vao{};
+    bool is_first_group{true};
+    for (const DrawGroup &draw_group : draw_groups)
+    {
+        const RenderItem &render_item{s_render_items[draw_group.first_item_index]};
+        const Shader &shader{get_material(render_item.material_id).shader};
+
+        // Each buffer starts without any state as the buffers are recorded independently
+        if (is_first_group || render_item.material_id != used_material_id)
+        {
+            command_buffer.record(UseMaterialCommand{render_item.material_id});
+            if (is_uniform_block_defined(shader.projection_block))
+            {
+                command_buffer.record(
+                    BindUniformBufferRangeCommand{ShaderUniformBlockType::PROJECTION, projection_buffer_range_id}
+                );
+            }
+            used_material_id = render_item.material_id;
+        }
+
+        bool is_instanced_draw{is_uniform_block_defined(shader.instance_block)};
+        if (draw_group.uses_draw_data)
+        {
+            command_buffer.record(BindStreamedUniformBufferRangeCommand{
+                .block_type = is_instanced_draw ? ShaderUniformBlockType::INSTANCE : ShaderUniformBlockType::DRAW,
+                .buffer_object = s_draw_data_buffer.buffer_object,
+                .offset = s_draw_data_buffer_offset + draw_group.draw_data_offset,
+                .size = is_instanced_draw ? INSTANCE_BLOCK_SIZE : DRAW_BLOCK_SIZE
+            });
+        }
+        else
+        {
+            if (render_item.options & WITH_LW_MATRIX)
+                command_buffer.record(SetLwMatrixCommand{render_item.lw_matrix});
+            if (render_item.options & WITH_LW_NORMAL_MATRIX)
+                command_buffer.record(SetLwNormalMatrixCommand{render_item.lw_normal_matrix});
+        }
+
+        MeshDrawCommands mesh_draw_commands{get_mesh_draw_commands(render_item.mesh_id)};
+        if (is_first_group || mesh_draw_commands.vertex_array_object != bound_vao)
+        {
+            command_buffer.record(BindVertexArrayCommand{mesh_draw_commands.vertex_array_object});
+            bound_vao = mesh_draw_commands.vertex_array_object;
+        }
+
+        std::uint32_t instance_count{is_instanced_draw ? draw_group.instance_count : 0};
+        command_buffer.record_mesh_draws(mesh_draw_commands.draw_commands, instance_count);
+
+        is_first_group = false;
+    }
+}
+
+// Recording only reads the render items and the materials, meshes and shaders, the GL calls are left to the execution
+void record_render_commands(UniformBufferRangeId projection_buffer_range_id)
+{
+    std::size_t draw_group_count{s_draw_groups.size()};
+    std::size_t slice_count{std::clamp<std::size_t>(
+        draw_group_count / MIN_RECORDED_DRAW_GROUP_COUNT, 1, RENDER_COMMAND_BUFFER_COUNT
+    )};
+
+    std::for_each(
+        std::execution::par,
+        s_render_command_buffer_indexes.begin(),
+        s_render_command_buffer_indexes.end(),
+        [&](std::uint32_t buffer_index) {
+            RenderCommandBuffer &command_buffer{s_render_command_buffers[buffer_index]};
+            if (buffer_index >= slice_count)
+            {
+                command_buffer.clear();
+                return;
+            }
+
+            AGE_PROFILE_SCOPE("record_render_command_slice");
+
+            std::size_t first_group_index{draw_group_count * buffer_index / slice_count};
+            std::size_t end_group_index{draw_group_count * (buffer_index + 1) / slice_count};
+            record_render_commands(
+                {s_draw_groups.begin() + first_group_index, s_draw_groups.begin() + end_group_index},
+                projection_buffer_range_id,
+                command_buffer
+            );
+        }
+    );
+}
+
 void render_camera(
     const CameraRenderState &camera_render_state,
     const WorldToViewMatrix &wv_matrix,
+    const ViewToClipMatrix &vc_matrix,
     const ProjectionUniformBuffer &projection_buffer
 )
 {
-    Core::process_components(std::function{[&](const Core::Transform &transform, LocalToViewMatrix &lv_matrix) {
-        calc_local_to_view_matrix(wv_matrix.matrix, transform, lv_matrix);
-    }});
-    Core::process_components(calc_local_to_view_normal_matrix);
+    AGE_PROFILE_SCOPE("render_camera");
+    AGE_PROFILE_GPU_SCOPE("render_camera");
+
+    {
+        AGE_PROFILE_SCOPE("cull_draw_calls");
+        cull_draw_calls(vc_matrix.matrix * wv_matrix.matrix);
+    }
+
+    {
+        AGE_PROFILE_SCOPE("sort_draw_calls");
+        // Depths are relative to the camera so draw calls are sorted per camera
+        sort_draw_calls(wv_matrix.matrix);
+        build_render_items();
+    }
+
+    // The shaders apply the world to view matrix, so the per draw data is shared by all the cameras
+    projection_buffer.buffer.update({.view_to_clip_matrix{vc_matrix.matrix}, .world_to_view_matrix{wv_matrix.matrix}});
 
     Core::process_components(std::function{[&](const LightGroup &light_group) {
         update_light_group_buffer(wv_matrix.matrix, light_group);
@@ -92,8 +843,13 @@ void render_camera(
         bool is_custom_viewport{camera_render_state.viewport_id != FULL_VIEWPORT_ID};
         if (is_custom_viewport)
         {
-            glEnable(GL_SCISSOR_TEST);
-            glScissor(viewport.origin_x, viewport.origin_y, viewport.width, viewport.height);
+            OGL::set_capability(OGL::Capability::SCISSOR_TEST, true);
+            OGL::set_scissor_box(
+                viewport.origin_x,
+                viewport.origin_y,
+                static_cast<GLsizei>(viewport.width),
+                static_cast<GLsizei>(viewport.height)
+            );
         }
 
         GLbitfield cleared_buffers{};
@@ -108,110 +864,184 @@ void render_camera(
             OGL::set_clear_depth(camera_render_state.clear_depth);
         }
         if (cleared_buffers)
-            glClear(cleared_buffers);
+            OGL::clear(cleared_buffers);
 
         if (is_custom_viewport)
-            glDisable(GL_SCISSOR_TEST);
+            OGL::set_capability(OGL::Capability::SCISSOR_TEST, false);
     }
 
-    if (camera_render_state.flags & DEPTH_CLAMPING)
-        glEnable(GL_DEPTH_CLAMP);
+    OGL::set_capability(OGL::Capability::DEPTH_CLAMP, (camera_render_state.flags & DEPTH_CLAMPING) != 0);
 
-    for (DrawCallKey draw_call_key : s_draw_call_keys)
+    stream_draw_data();
     {
-        const DrawCall &draw_call{s_draw_calls[draw_call_key.index]};
-        const Material &material{use_material(draw_call.material_id)};
-        Shader &shader{material.shader};
-
-        if (is_uniform_block_defined(shader.projection_block))
-        {
-            bind_uniform_buffer_range(
-                shader.shader_program, shader.projection_block, projection_buffer.buffer_range_id
-            );
-        }
-
-        if (draw_call.lv_matrix != nullptr)
-            OGL::set_uniform(shader.lv_matrix, *draw_call.lv_matrix);
-        if (draw_call.lv_normal_matrix != nullptr)
-            OGL::set_uniform(shader.lv_normal_matrix, *draw_call.lv_normal_matrix);
-
-        MeshDrawCommands mesh_draw_commands{get_mesh_draw_commands(draw_call.mesh_id)};
-        if (mesh_draw_commands.vertex_array_object != s_bound_vao)
-        {
-            OGL::bind_vertex_array_object(mesh_draw_commands.vertex_array_object);
-            s_bound_vao = mesh_draw_commands.vertex_array_object;
-        }
-
-        for (const DrawCommand &draw_command : mesh_draw_commands.draw_commands)
-        {
-            switch (draw_command.type)
-            {
-            case DrawCommandType::DRAW_ARRAYS:
-                OGL::draw_arrays(draw_command.rendering_mode, draw_command.element_count, draw_command.offset);
-                break;
-            case DrawCommandType::DRAW_ELEMENTS:
-                OGL::draw_elements(draw_command.rendering_mode, draw_command.element_count, draw_command.offset);
-                break;
-            }
-        }
+        AGE_PROFILE_SCOPE("record_render_commands");
+        record_render_commands(projection_buffer.buffer_range_id);
+    }
+    {
+        AGE_PROFILE_SCOPE("execute_render_commands");
+        for (const RenderCommandBuffer &command_buffer : s_render_command_buffers)
+            command_buffer.execute();
     }
-
-    if (camera_render_state.flags & DEPTH_CLAMPING)
-        glDisable(GL_DEPTH_CLAMP);
 }
-} // namespace
 
-void init_rendering_system(GLFWwindow *window)
+void init_common_rendering_system()
 {
-    s_window = window;
-
     s_draw_calls.reserve(2048);
+    s_extracted_draw_calls.reserve(2048);
+    s_draw_list.reserve(2048);
+    s_draw_list_buffer.reserve(2048);
+    s_added_draw_call_keys.reserve(2048);
+    s_removed_draw_call_keys.reserve(256);
+    s_draw_call_ranks.reserve(2048);
+    s_dynamic_draw_call_indexes.reserve(2048);
+    s_moved_draw_call_indexes.reserve(2048);
+    s_updated_draw_call_indexes.reserve(2048);
+    s_unbounded_draw_call_indexes.reserve(2048);
+    s_visible_draw_call_indexes.reserve(2048);
+    s_visible_draw_call_ranks.reserve(2048);
+    s_visible_draw_call_rank_buffer.reserve(2048);
     s_draw_call_keys.reserve(2048);
+    s_draw_call_key_buffer.reserve(2048);
+    s_render_items.reserve(2048);
+    s_draw_groups.reserve(2048);
+    std::iota(s_render_command_buffer_indexes.begin(), s_render_command_buffer_indexes.end(), 0U);
 
-    init_viewport_system(window);
     init_mesh_system();
     init_shader_system();
     init_material_system();
     init_uniform_buffer_system();
     init_texture_system();
 
-    glfwSwapInterval(1);
+    s_draw_data_buffer = StreamingUniformBuffer{OGL::create_uniform_buffer(), DRAW_DATA_BUFFER_SIZE};
 
-    glEnable(GL_CULL_FACE);
+    OGL::set_capability(OGL::Capability::CULL_FACE, true);
     glFrontFace(GL_CW);
     glCullFace(GL_BACK);
 
-    glEnable(GL_DEPTH_TEST);
+    OGL::set_capability(OGL::Capability::DEPTH_TEST, true);
     glDepthMask(true);
     glDepthFunc(GL_LEQUAL);
     glDepthRange(0.0, 1.0);
 }
+} // namespace
+
+void init_rendering_system(GLFWwindow *window)
+{
+    s_window = window;
+
+    init_viewport_system(window);
+    init_common_rendering_system();
+
+#ifndef AGE_RECORDING_OGL
+    glfwSwapInterval(1);
+#endif
+}
+
+void init_headless_rendering_system(unsigned int framebuffer_width, unsigned int framebuffer_height)
+{
+    init_viewport_system(framebuffer_width, framebuffer_height);
+    init_common_rendering_system();
+}
 
 void init_renderer(Core::EntityId entity_id, unsigned int options)
 {
     auto [renderer, material, mesh] =
         Core::get_entity_components<Renderer, const MaterialRef, const MeshRef>(entity_id);
 
-    const Math::Matrix4 *lv_matrix{};
-    if (options & WITH_LV_MATRIX)
-        lv_matrix = &Core::get_entity_component<const LocalToViewMatrix>(entity_id).matrix;
+    init_renderer(entity_id, renderer, options, material.material_id, mesh.mesh_id);
+}
+
+void set_renderer_active(Core::EntityId entity_id, bool is_active)
+{
+    Renderer &renderer{Core::get_entity_component<Renderer>(entity_id)};
+    if (renderer.is_active == is_active)
+        return;
+
+    renderer.is_active = is_active;
+    if (renderer.draw_call_key.index == INVALID_DRAW_CALL_INDEX)
+        return;
+
+    if (is_active)
+        add_to_draw_list(renderer.draw_call_key);
+    else
+        remove_from_draw_list(renderer.draw_call_key);
+}
+
+void set_renderer_material(Core::EntityId entity_id, MaterialId material_id)
+{
+    auto [renderer, material] = Core::get_entity_components<Renderer, MaterialRef>(entity_id);
+    material.material_id = material_id;
+
+    if (renderer.draw_call_key.index != INVALID_DRAW_CALL_INDEX)
+        set_draw_call_state(renderer, material_id, s_draw_calls[renderer.draw_call_key.index].mesh_id);
+}
+
+void set_renderer_mesh(Core::EntityId entity_id, MeshId mesh_id)
+{
+    auto [renderer, mesh] = Core::get_entity_components<Renderer, MeshRef>(entity_id);
+    mesh.mesh_id = mesh_id;
+
+    if (renderer.draw_call_key.index == INVALID_DRAW_CALL_INDEX)
+        return;
+
+    set_draw_call_state(renderer, s_draw_calls[renderer.draw_call_key.index].material_id, mesh_id);
+    // The bounds follow the mesh
+    mark_draw_call_moved(renderer.draw_call_key.index);
+}
+
+void mark_renderer_moved(Core::EntityId entity_id)
+{
+    const Renderer &renderer{Core::get_entity_component<const Renderer>(entity_id)};
+    if (renderer.draw_call_key.index != INVALID_DRAW_CALL_INDEX)
+        mark_draw_call_moved(renderer.draw_call_key.index);
+}
+
+void remove_renderer(Core::EntityId entity_id)
+{
+    release_draw_call(Core::get_entity_component<Renderer>(entity_id));
+}
 
-    const Math::Matrix3 *lv_normal_matrix{};
-    if (options & WITH_LV_NORMAL_MATRIX)
-        lv_normal_matrix = &Core::get_entity_component<const LocalToViewNormalMatrix>(entity_id).matrix;
+void Renderer::on_destroy(Core::EntityId, Renderer &renderer)
+{
+    release_draw_call(renderer);
+}
 
-    init_renderer(renderer, lv_matrix, lv_normal_matrix, material.material_id, mesh.mesh_id);
+const BoundingVolumeHierarchy &get_scene_bvh()
+{
+    return s_scene_bvh;
 }
 
 void render()
 {
+    AGE_PROFILE_SCOPE("render");
+
     end_viewports_update();
 
-    sort_draw_calls();
+    {
+        AGE_PROFILE_SCOPE("update_draw_calls");
+        // The cameras only read the extracted data from here on
+        update_draw_calls();
+    }
+    {
+        AGE_PROFILE_SCOPE("update_scene_bvh");
+        s_scene_bvh.update();
+    }
+    {
+        AGE_PROFILE_SCOPE("update_draw_list");
+        update_draw_list();
+    }
     Core::process_components(render_camera);
     release_used_material();
 
-    glfwSwapBuffers(s_window);
+#ifndef AGE_RECORDING_OGL
+    if (s_window != nullptr)
+    {
+        AGE_PROFILE_SCOPE("swap_buffers");
+        glfwSwapBuffers(s_window);
+    }
+#endif
+
+    update_render_stats();
 }
 
 void update_render_state()
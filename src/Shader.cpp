@@ -11,7 +11,6 @@ namespace
 constexpr ShaderRenderState DEFAULT_SHADER_RENDER_STATE{.srgb_rendering = false};
 
 ShaderRenderState s_current_shader_render_state{DEFAULT_SHADER_RENDER_STATE};
-GLuint s_used_shader_program;
 
 std::string read_file(std::string_view path)
 {
@@ -95,9 +94,17 @@ Shader::Shader(GLuint shader_program, ShaderCommonUniforms common_uniforms, Shad
     : render_state{render_state}
     , shader_program{shader_program}
     , projection_block{common_uniforms.projection_block ? UniformBlock{OGL::get_uniform_block_index(shader_program, "ProjectionBlock")} : UniformBlock{}}
-    , lv_matrix{common_uniforms.lv_matrix ? OGL::get_uniform_location(shader_program, "_localToViewMatrix") : -1}
-    , lv_normal_matrix{
-          common_uniforms.lv_normal_matrix ? OGL::get_uniform_location(shader_program, "_localToViewNormalMatrix") : -1
+    , lw_matrix{common_uniforms.lw_matrix ? OGL::get_uniform_location(shader_program, "_localToWorldMatrix") : -1}
+    , lw_normal_matrix{
+          common_uniforms.lw_normal_matrix ? OGL::get_uniform_location(shader_program, "_localToWorldNormalMatrix") : -1
+      }
+    , instance_block{
+          common_uniforms.instancing ? UniformBlock{OGL::get_uniform_block_index(shader_program, "InstanceBlock")}
+                                     : UniformBlock{}
+      }
+    , draw_block{
+          common_uniforms.draw_block ? UniformBlock{OGL::get_uniform_block_index(shader_program, "DrawBlock")}
+                                     : UniformBlock{}
       }
 {
 }
@@ -131,11 +138,7 @@ Shader &get_shader(ShaderId shader_id)
 
 void use_shader(const Shader &shader)
 {
-    if (shader.shader_program != s_used_shader_program)
-    {
-        update_shader_render_state(shader.render_state);
-        OGL::use_shader(shader.shader_program);
-        s_used_shader_program = shader.shader_program;
-    }
+    update_shader_render_state(shader.render_state);
+    OGL::use_shader(shader.shader_program);
 }
 } // namespace Age::Gfx
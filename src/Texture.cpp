@@ -700,8 +700,7 @@ GLuint load_1d_texture(const TextureData &texture_data, TextureUnitId texture_un
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_1D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_1D, texture);
 
     GLint unpack_alignment{get_pixel_data_unpack_alignment()};
 
@@ -742,7 +741,7 @@ GLuint load_1d_texture(const TextureData &texture_data, TextureUnitId texture_un
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_1D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_1D, 0);
 
     return texture;
 }
@@ -755,8 +754,7 @@ GLuint load_2d_texture(const TextureData &texture_data, TextureUnitId texture_un
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_2D, texture);
 
     GLint unpack_alignment{get_pixel_data_unpack_alignment()};
 
@@ -799,7 +797,7 @@ GLuint load_2d_texture(const TextureData &texture_data, TextureUnitId texture_un
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_2D, 0);
 
     return texture;
 }
@@ -814,8 +812,7 @@ GLuint load_cube_map_texture(
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_CUBE_MAP, texture);
 
     GLint unpack_alignment{get_pixel_data_unpack_alignment()};
 
@@ -868,7 +865,7 @@ GLuint load_cube_map_texture(
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_CUBE_MAP, 0);
 
     return texture;
 }
@@ -881,8 +878,7 @@ GLuint load_3d_texture(const TextureData &texture_data, TextureUnitId texture_un
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_3D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_3D, texture);
 
     GLint unpack_alignment{get_pixel_data_unpack_alignment()};
 
@@ -927,7 +923,7 @@ GLuint load_3d_texture(const TextureData &texture_data, TextureUnitId texture_un
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_3D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_3D, 0);
 
     return texture;
 }
@@ -941,8 +937,7 @@ GLuint load_compressed_1d_texture(
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_1D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_1D, texture);
 
     if (texture_data.desc.mipmap_level_count > 1)
     {
@@ -975,7 +970,7 @@ GLuint load_compressed_1d_texture(
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_1D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_1D, 0);
 
     return texture;
 }
@@ -989,8 +984,7 @@ GLuint load_compressed_2d_texture(
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_2D, texture);
 
     if (texture_data.desc.mipmap_level_count > 1)
     {
@@ -1025,7 +1019,7 @@ GLuint load_compressed_2d_texture(
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_2D, 0);
 
     return texture;
 }
@@ -1039,8 +1033,7 @@ GLuint load_compressed_cube_map_texture(
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_CUBE_MAP, texture);
 
     if (texture_data.desc.mipmap_level_count > 1)
     {
@@ -1085,7 +1078,7 @@ GLuint load_compressed_cube_map_texture(
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_CUBE_MAP, 0);
 
     return texture;
 }
@@ -1099,8 +1092,7 @@ GLuint load_compressed_3d_texture(
 
     GLuint texture;
     glGenTextures(1, &texture);
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(GL_TEXTURE_3D, texture);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_3D, texture);
 
     if (texture_data.desc.mipmap_level_count > 1)
     {
@@ -1137,7 +1129,7 @@ GLuint load_compressed_3d_texture(
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, texture_data.desc.mipmap_level_count - 1);
 
-    glBindTexture(GL_TEXTURE_3D, 0);
+    OGL::bind_texture(texture_unit_id, GL_TEXTURE_3D, 0);
 
     return texture;
 }
@@ -1179,8 +1171,7 @@ GLuint load_texture(const TextureData &texture_data, TextureUnitId texture_unit_
 
 void bind_texture(TextureId texture_id, Texture &texture, TextureUnitId texture_unit_id, TextureUnit &texture_unit)
 {
-    glActiveTexture(GL_TEXTURE0 + texture_unit_id);
-    glBindTexture(to_gl_enum(texture.type), texture.texture);
+    OGL::bind_texture(texture_unit_id, to_gl_enum(texture.type), texture.texture);
 
     texture.bound_texture_unit_id = texture_unit_id;
     texture_unit.bound_texture_id = texture_id;
@@ -1250,7 +1241,7 @@ void update_sampler_params(GLuint sampler, const SamplerParams &params, const Sa
 
 void bind_sampler(SamplerId sampler_id, Sampler &sampler, TextureUnitId texture_unit_id, TextureUnit &texture_unit)
 {
-    glBindSampler(static_cast<GLuint>(texture_unit_id), sampler.sampler);
+    OGL::bind_sampler(texture_unit_id, sampler.sampler);
 
     sampler.bound_texture_unit_id = texture_unit_id;
     texture_unit.bound_sampler_id = sampler_id;
@@ -1,13 +1,24 @@
+#include <chrono>
+
 #include "Time.hpp"
-#include "GLFW.hpp"
 
 namespace Age::Time
 {
 namespace
 {
+using Clock = std::chrono::steady_clock;
+
+Clock::time_point s_start_time{Clock::now()};
+float s_fixed_delta_time;
+
 double s_prev_frame_time;
 double s_current_frame_time;
 float s_delta_time;
+
+double get_time()
+{
+    return std::chrono::duration<double>(Clock::now() - s_start_time).count();
+}
 } // namespace
 
 float frame_time()
@@ -22,18 +33,22 @@ float delta_time()
 
 float current_time()
 {
-    return static_cast<float>(glfwGetTime());
+    return static_cast<float>(get_time());
 }
 
-void init_frame_time()
+void init_frame_time(float fixed_delta_time)
 {
-    s_current_frame_time = glfwGetTime();
+    s_fixed_delta_time = fixed_delta_time;
+    s_current_frame_time = s_fixed_delta_time != 0.0f ? 0.0 : get_time();
 }
 
 void update_frame_time()
 {
     s_prev_frame_time = s_current_frame_time;
-    s_current_frame_time = glfwGetTime();
+    if (s_fixed_delta_time != 0.0f)
+        s_current_frame_time += s_fixed_delta_time;
+    else
+        s_current_frame_time = get_time();
     s_delta_time = static_cast<float>(s_current_frame_time - s_prev_frame_time);
 }
 } // namespace Age::Time
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "IdGenerator.hpp"
@@ -10,10 +12,16 @@ namespace
 GLuint s_uniform_buffer_binding_count;
 std::size_t s_uniform_buffer_offset_alignment;
 
+// The last binding is reserved for streamed ranges
+GLuint s_streamed_binding_index;
+
 std::vector<std::uint32_t> s_binding_use_counts;
 std::vector<UniformBufferRangeId> s_binding_uniform_buffer_ranges;
 
-Util::IdGenerator<UniformBufferRangeId> s_uniform_buffer_range_id_generator{UniformBufferRangeId{1}};
+// Range ids hold a 24 bits index and an 8 bits generation
+using UniformBufferRangeIdGenerator = Util::ConcurrentIdGenerator<UniformBufferRangeId, 24>;
+
+UniformBufferRangeIdGenerator s_uniform_buffer_range_id_generator{UniformBufferRangeId{1}};
 std::vector<UniformBufferRange> s_uniform_buffer_ranges;
 std::vector<UniformBufferBinding> s_uniform_buffer_range_bindings;
 
@@ -29,7 +37,7 @@ constexpr UniformBufferBinding to_binding(std::size_t index)
 
 constexpr std::size_t to_index(UniformBufferRangeId id)
 {
-    return static_cast<std::size_t>(id) - 1;
+    return UniformBufferRangeIdGenerator::index_of(id) - 1;
 }
 
 constexpr UniformBufferRangeId to_range_id(std::size_t index)
@@ -43,7 +51,7 @@ UniformBufferBinding get_least_used_uniform_buffer_binding()
         return to_binding(0);
 
     std::size_t least_used_binding_index{0};
-    std::size_t max_binding_index{s_uniform_buffer_binding_count};
+    std::size_t max_binding_index{s_streamed_binding_index};
     for (std::size_t binding_index{1}; binding_index < max_binding_index; ++binding_index)
     {
         std::uint32_t use_count{s_binding_use_counts[binding_index]};
@@ -108,6 +116,11 @@ std::size_t get_uniform_block_aligned_size(std::size_t block_size)
     return block_size + s_uniform_buffer_offset_alignment - (block_size % s_uniform_buffer_offset_alignment);
 }
 
+std::size_t get_uniform_buffer_offset_alignment()
+{
+    return s_uniform_buffer_offset_alignment;
+}
+
 bool is_uniform_block_defined(UniformBlock uniform_block)
 {
     return uniform_block.block_index != GL_INVALID_INDEX;
@@ -116,6 +129,9 @@ bool is_uniform_block_defined(UniformBlock uniform_block)
 UniformBufferRangeId create_uniform_buffer_range(const UniformBufferRange &uniform_buffer_range)
 {
     UniformBufferRangeId id{s_uniform_buffer_range_id_generator.generate()};
+    if (id == UniformBufferRangeId{})
+        return id;
+
     std::size_t index{to_index(id)};
 
     if (index == s_uniform_buffer_ranges.size())
@@ -135,11 +151,53 @@ void destroy_uniform_buffer_range(UniformBufferRangeId uniform_buffer_range_id)
     s_uniform_buffer_range_id_generator.destroy(uniform_buffer_range_id);
 }
 
+StreamingUniformBuffer::StreamingUniformBuffer(GLuint buffer_object, std::size_t size)
+    : buffer_object{buffer_object}
+    , size{size}
+{
+    OGL::allocate_uniform_buffer(buffer_object, size);
+}
+
+std::size_t StreamingUniformBuffer::write(const void *data, std::size_t data_size)
+{
+    std::size_t alignment{s_uniform_buffer_offset_alignment};
+    std::size_t write_offset{(offset + alignment - 1) / alignment * alignment};
+
+    if (write_offset + data_size > size)
+    {
+        // Orphaning gives back a new buffer while the GPU keeps reading the old one
+        size = std::max(size, data_size);
+        OGL::allocate_uniform_buffer(buffer_object, size);
+        write_offset = 0;
+    }
+
+    void *buffer{OGL::map_uniform_buffer(
+        buffer_object,
+        write_offset,
+        data_size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+    )};
+    if (buffer != nullptr)
+    {
+        std::memcpy(buffer, data, data_size);
+        OGL::unmap_uniform_buffer(buffer_object);
+    }
+    else
+    {
+        OGL::write_uniform_buffer(buffer_object, write_offset, data, data_size);
+    }
+
+    offset = write_offset + data_size;
+    return write_offset;
+}
+
 void init_uniform_buffer_system()
 {
     s_uniform_buffer_binding_count = static_cast<GLuint>(OGL::get_integer(GL_MAX_UNIFORM_BUFFER_BINDINGS));
     s_uniform_buffer_offset_alignment = static_cast<std::size_t>(OGL::get_integer(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT));
 
+    s_streamed_binding_index = s_uniform_buffer_binding_count - 1;
+
     s_binding_use_counts.resize(s_uniform_buffer_binding_count);
     s_binding_uniform_buffer_ranges.resize(s_uniform_buffer_binding_count);
 
@@ -165,4 +223,12 @@ void bind_uniform_buffer_range(
         bind_uniform_block(shader_program, uniform_block, buffer_binding);
     }
 }
+
+void bind_streamed_uniform_buffer_range(
+    GLuint shader_program, UniformBlock &uniform_block, GLuint buffer_object, std::size_t offset, std::size_t size
+)
+{
+    bind_uniform_block(shader_program, uniform_block, to_binding(s_streamed_binding_index));
+    OGL::bind_uniform_buffer_range(s_streamed_binding_index, buffer_object, offset, size);
+}
 } // namespace Age::Gfx
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "VertexEncoding.hpp"
+
+namespace Age::Gfx
+{
+namespace
+{
+std::uint32_t encode_snorm10(float value)
+{
+    auto encoded_value{static_cast<std::int32_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 511.0f))};
+    return static_cast<std::uint32_t>(encoded_value) & 0x3FF;
+}
+
+std::uint32_t encode_unorm8(float value)
+{
+    return static_cast<std::uint32_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+} // namespace
+
+std::uint16_t encode_half_float(float value)
+{
+    auto bits{std::bit_cast<std::uint32_t>(value)};
+    std::uint32_t sign{(bits >> 16) & 0x8000};
+    std::uint32_t float_exponent{(bits >> 23) & 0xFF};
+    std::uint32_t mantissa{bits & 0x7FFFFF};
+
+    // Infinities and NaNs, NaNs keep a mantissa bit
+    if (float_exponent == 0xFF)
+        return static_cast<std::uint16_t>(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+
+    auto exponent{static_cast<std::int32_t>(float_exponent) - 127 + 15};
+    if (exponent >= 31)
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+
+    // Subnormal half floats, the implicit mantissa bit becomes explicit
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return static_cast<std::uint16_t>(sign);
+
+        mantissa |= 0x800000;
+        auto shift{static_cast<std::uint32_t>(14 - exponent)};
+        std::uint32_t half_mantissa{mantissa >> shift};
+        if ((mantissa >> (shift - 1)) & 1)
+            ++half_mantissa;
+        return static_cast<std::uint16_t>(sign | half_mantissa);
+    }
+
+    // A carry out of the mantissa correctly increments the exponent
+    std::uint32_t half{sign | (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13)};
+    if (mantissa & 0x1000)
+        ++half;
+    return static_cast<std::uint16_t>(half);
+}
+
+std::uint32_t encode_packed_normal(const Math::Vector3 &normal)
+{
+    return encode_snorm10(normal.x) | encode_snorm10(normal.y) << 10 | encode_snorm10(normal.z) << 20;
+}
+
+std::uint32_t encode_byte_color(const Math::Vector3 &color)
+{
+    return encode_unorm8(color.x) | encode_unorm8(color.y) << 8 | encode_unorm8(color.z) << 16 | 0xFFU << 24;
+}
+} // namespace Age::Gfx
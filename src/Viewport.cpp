@@ -1,4 +1,3 @@
-#include <limits>
 #include <vector>
 
 #include "OpenGL.hpp"
@@ -20,7 +19,6 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 }
 
 std::vector<Viewport> s_viewports{};
-ViewportId s_used_viewport_id{std::numeric_limits<ViewportId>::max()};
 } // namespace
 
 bool has_framebuffer_size_changed()
@@ -38,13 +36,20 @@ void init_viewport_system(GLFWwindow *window)
 {
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    glfwGetFramebufferSize(window, &s_framebuffer_width, &s_framebuffer_height);
+    int framebuffer_width{};
+    int framebuffer_height{};
+    glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+    init_viewport_system(static_cast<unsigned int>(framebuffer_width), static_cast<unsigned int>(framebuffer_height));
+}
+
+void init_viewport_system(unsigned int framebuffer_width, unsigned int framebuffer_height)
+{
+    s_framebuffer_width = static_cast<int>(framebuffer_width);
+    s_framebuffer_height = static_cast<int>(framebuffer_height);
     s_framebuffer_size_changed = true;
 
     s_viewports.reserve(8);
-    s_viewports.emplace_back(
-        0, 0, static_cast<unsigned int>(s_framebuffer_width), static_cast<unsigned int>(s_framebuffer_height)
-    );
+    s_viewports.emplace_back(0, 0, framebuffer_width, framebuffer_height);
 }
 
 void start_viewports_update()
@@ -55,8 +60,6 @@ void start_viewports_update()
     Viewport &full_viewport{s_viewports[FULL_VIEWPORT_ID]};
     full_viewport.width = static_cast<unsigned int>(s_framebuffer_width);
     full_viewport.height = static_cast<unsigned int>(s_framebuffer_height);
-
-    s_used_viewport_id = std::numeric_limits<ViewportId>::max();
 }
 
 void end_viewports_update()
@@ -79,17 +82,12 @@ const Viewport &use_viewport(ViewportId viewport_id)
 {
     const Viewport &viewport{s_viewports[viewport_id]};
 
-    if (viewport_id != s_used_viewport_id)
-    {
-        glViewport(
-            viewport.origin_x,
-            viewport.origin_y,
-            static_cast<GLsizei>(viewport.width),
-            static_cast<GLsizei>(viewport.height)
-        );
-
-        s_used_viewport_id = viewport_id;
-    }
+    OGL::set_viewport(
+        viewport.origin_x,
+        viewport.origin_y,
+        static_cast<GLsizei>(viewport.width),
+        static_cast<GLsizei>(viewport.height)
+    );
 
     return viewport;
 }
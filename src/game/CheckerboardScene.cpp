@@ -225,7 +225,6 @@ void CheckerBoardScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{},
-            Gfx::LocalToViewMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{mesh_id},
             Gfx::Renderer{},
@@ -236,7 +235,7 @@ void CheckerBoardScene::init() const
             }
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX);
     }
 }
 
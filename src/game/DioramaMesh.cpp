@@ -1,3 +1,4 @@
+#include "OcclusionCulling.hpp"
 #include "OpenGL.hpp"
 #include "Vector.hpp"
 
@@ -123,4 +124,9 @@ void create_diorama_mesh(Age::Gfx::MeshBuffers &mesh_buffers, std::span<Age::Gfx
         draw_commands[0]
     );
 }
+
+void create_diorama_occluder_mesh(Age::Gfx::MeshId mesh_id)
+{
+    Gfx::create_occluder_mesh(mesh_id, s_positions, s_indexes);
+}
 } // namespace Game
@@ -253,14 +253,12 @@ void DoubleProjectionScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{},
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     Core::process_components(Gfx::calc_spherical_camera_view_matrix);
@@ -42,10 +42,10 @@ const GLushort s_plane_indexes[] = {
 void create_plane_mesh(Gfx::MeshBuffers &mesh_buffers, std::span<Gfx::DrawCommand, 1> draw_commands)
 {
     glGenVertexArrays(1, &mesh_buffers.vertex_array_object);
-    glBindVertexArray(mesh_buffers.vertex_array_object);
+    Gfx::OGL::bind_vertex_array_object(mesh_buffers.vertex_array_object);
 
     glGenBuffers(1, &mesh_buffers.vertex_buffer_object);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffers.vertex_buffer_object);
+    Gfx::OGL::bind_array_buffer(mesh_buffers.vertex_buffer_object);
     glBufferData(GL_ARRAY_BUFFER, sizeof(s_plane_vertices), s_plane_vertices, GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
@@ -59,8 +59,8 @@ void create_plane_mesh(Gfx::MeshBuffers &mesh_buffers, std::span<Gfx::DrawComman
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh_buffers.index_buffer_object);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(s_plane_indexes), s_plane_indexes, GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    Gfx::OGL::bind_vertex_array_object(0);
+    Gfx::OGL::bind_array_buffer(0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     draw_commands[0] = {
@@ -156,10 +156,10 @@ void GammaAndTexturesScene::init() const
         material.sampler_id = nearest_clamp_sampler_id;
 
         auto id = Core::create_entity(
-            Gfx::LocalToViewMatrix{.matrix{1.0f}}, Gfx::MaterialRef{material_id}, Gfx::MeshRef{mesh_id}, Gfx::Renderer{}
+            Core::Transform{}, Gfx::MaterialRef{material_id}, Gfx::MeshRef{mesh_id}, Gfx::Renderer{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX);
     }
 }
 
@@ -16647,7 +16647,8 @@ void create_ground_mesh(Gfx::MeshBuffers &mesh_buffer, std::span<Gfx::DrawComman
         sizeof(s_indexes) / sizeof(s_indexes[0]),
         Gfx::OGL::RenderingMode::TRIANGLES,
         mesh_buffer,
-        draw_commands[0]
+        draw_commands[0],
+        Gfx::BYTE_COLORS | Gfx::PACKED_NORMALS
     );
 }
 } // namespace Game
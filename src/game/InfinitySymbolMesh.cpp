@@ -4539,7 +4539,8 @@ void create_infinity_symbol_mesh(Age::Gfx::MeshBuffers &mesh_buffer, std::span<A
         sizeof(s_indexes) / sizeof(s_indexes[0]),
         Gfx::OGL::RenderingMode::TRIANGLES,
         mesh_buffer,
-        draw_commands[0]
+        draw_commands[0],
+        Gfx::COMPACT_VERTICES
     );
 }
 } // namespace Game
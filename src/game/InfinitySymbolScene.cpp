@@ -38,7 +38,7 @@ struct InfinitySymbolShader : public Gfx::Shader
     GLint use_shininess_texture{-1};
 
     InfinitySymbolShader(GLuint shader_program)
-        : Shader{shader_program, {.lv_normal_matrix = true}}
+        : Shader{shader_program, {.lw_normal_matrix = true}}
         , light_block{Gfx::OGL::get_uniform_block_index(shader_program, "LightBlock")}
         , material_block{Gfx::OGL::get_uniform_block_index(shader_program, "MaterialBlock")}
         , gaussian_texture{Gfx::OGL::get_uniform_location(shader_program, "_gaussianTexture")}
@@ -131,9 +131,12 @@ void InfinitySymbolScene::init() const
         }
     }
 
+    constexpr int gaussian_texture_image_unit{1};
+    constexpr int shininess_texture_image_unit{2};
+
     GLuint gaussian_texture;
     glGenTextures(1, &gaussian_texture);
-    glBindTexture(GL_TEXTURE_2D, gaussian_texture);
+    Gfx::OGL::bind_texture(gaussian_texture_image_unit, GL_TEXTURE_2D, gaussian_texture);
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
@@ -147,7 +150,6 @@ void InfinitySymbolScene::init() const
     );
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
 
     Gfx::TextureData texture{};
     if (!Gfx::read_texture_data_from_dds_file("assets/game/textures/shininess.dds", texture))
@@ -155,7 +157,7 @@ void InfinitySymbolScene::init() const
 
     GLuint shininess_texture;
     glGenTextures(1, &shininess_texture);
-    glBindTexture(GL_TEXTURE_2D, shininess_texture);
+    Gfx::OGL::bind_texture(shininess_texture_image_unit, GL_TEXTURE_2D, shininess_texture);
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
@@ -169,16 +171,6 @@ void InfinitySymbolScene::init() const
     );
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    constexpr int gaussian_texture_image_unit{1};
-    constexpr int shininess_texture_image_unit{2};
-
-    glActiveTexture(GL_TEXTURE0 + gaussian_texture_image_unit);
-    glBindTexture(GL_TEXTURE_2D, gaussian_texture);
-
-    glActiveTexture(GL_TEXTURE0 + shininess_texture_image_unit);
-    glBindTexture(GL_TEXTURE_2D, shininess_texture);
 
     GLuint texture_sampler;
     glGenSamplers(1, &texture_sampler);
@@ -187,8 +179,8 @@ void InfinitySymbolScene::init() const
     glSamplerParameteri(texture_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glSamplerParameteri(texture_sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glBindSampler(gaussian_texture_image_unit, texture_sampler);
-    glBindSampler(shininess_texture_image_unit, texture_sampler);
+    Gfx::OGL::bind_sampler(gaussian_texture_image_unit, texture_sampler);
+    Gfx::OGL::bind_sampler(shininess_texture_image_unit, texture_sampler);
 
     // Camera
     {
@@ -232,14 +224,13 @@ void InfinitySymbolScene::init() const
 
         auto point_light_id = Core::create_entity(
             Core::Transform{.position{10.0f, 0.0f, 1.0f}, .scale{0.5f}},
-            Gfx::LocalToViewMatrix{},
             Gfx::MaterialRef{unlit_color_material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
             Gfx::PointLight{.light_intensity{0.4f, 0.4f, 0.4f, 1.0f}}
         );
 
-        Gfx::init_renderer(point_light_id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(point_light_id, Gfx::WITH_LW_MATRIX);
 
         Core::create_entity(
             Gfx::LightGroup{
@@ -284,15 +275,13 @@ void InfinitySymbolScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{.scale{4.0f}},
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{infinity_mesh_id},
             Gfx::Renderer{},
             InfinitySymbol{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 }
 
@@ -1,3 +1,9 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Math.hpp"
+
 #include "game/Meshes.hpp"
 
 namespace Game
@@ -9,11 +15,11 @@ void create_sphere_impostors_mesh(
 )
 {
     glGenBuffers(1, &mesh_buffer.vertex_buffer_object);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh_buffer.vertex_buffer_object);
+    Gfx::OGL::bind_array_buffer(mesh_buffer.vertex_buffer_object);
     glBufferData(GL_ARRAY_BUFFER, sizeof(SphereImpostor) * impostor_count, nullptr, GL_DYNAMIC_DRAW);
 
     glGenVertexArrays(1, &mesh_buffer.vertex_array_object);
-    glBindVertexArray(mesh_buffer.vertex_array_object);
+    Gfx::OGL::bind_vertex_array_object(mesh_buffer.vertex_array_object);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, false, sizeof(SphereImpostor), 0);
     glEnableVertexAttribArray(1);
@@ -21,8 +27,8 @@ void create_sphere_impostors_mesh(
         1, 1, GL_FLOAT, false, sizeof(SphereImpostor), reinterpret_cast<GLvoid *>(offsetof(SphereImpostor, radius))
     );
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    Gfx::OGL::bind_vertex_array_object(0);
+    Gfx::OGL::bind_array_buffer(0);
 
     draw_commands[0] = Gfx::DrawCommand{
         .type{Gfx::DrawCommandType::DRAW_ARRAYS},
@@ -31,4 +37,145 @@ void create_sphere_impostors_mesh(
         .offset{0}
     };
 }
+
+void create_waymark_mesh(
+    Age::Gfx::MeshBuffers &mesh_buffer,
+    std::span<Age::Gfx::DrawCommand, 1> draw_commands,
+    Age::Math::Vector3 position,
+    Age::Math::Vector3 color
+)
+{
+    constexpr float HALF_WIDTH{0.35f};
+    constexpr float HEIGHT{1.6f};
+
+    const Math::Vector3 positions[]{
+        position + Math::Vector3{-HALF_WIDTH, 0.0f, HALF_WIDTH},
+        position + Math::Vector3{HALF_WIDTH, 0.0f, HALF_WIDTH},
+        position + Math::Vector3{HALF_WIDTH, 0.0f, -HALF_WIDTH},
+        position + Math::Vector3{-HALF_WIDTH, 0.0f, -HALF_WIDTH},
+        position + Math::Vector3{0.0f, HEIGHT, 0.0f}
+    };
+    const Math::Vector3 colors[]{color * 0.4f, color * 0.4f, color * 0.4f, color * 0.4f, color};
+    // Clockwise seen from outside
+    const unsigned short indexes[]{0, 4, 1, 1, 4, 2, 2, 4, 3, 3, 4, 0};
+
+    Gfx::create_elements_mesh(
+        positions,
+        colors,
+        nullptr,
+        nullptr,
+        sizeof(positions) / sizeof(positions[0]),
+        indexes,
+        sizeof(indexes) / sizeof(indexes[0]),
+        Gfx::OGL::RenderingMode::TRIANGLES,
+        mesh_buffer,
+        draw_commands[0]
+    );
+}
+
+void create_meadow_mesh(
+    Age::Gfx::MeshBuffers &mesh_buffer,
+    std::span<Age::Gfx::DrawCommand, 2> draw_commands,
+    Age::Math::Vector3 position,
+    float radius
+)
+{
+    // Heptagon, its odd triangle count leaves the 16 bit indices on a 2 byte boundary
+    constexpr std::uint32_t PATCH_SIDE_COUNT{7};
+    // 5 vertices a blade, past the 65536 vertices reachable by 16 bit indices
+    constexpr std::uint32_t BLADE_COUNT{13210};
+    constexpr float GOLDEN_ANGLE{2.39996323f};
+
+    Math::Vector3 patch_positions[PATCH_SIDE_COUNT + 1]{position + Math::Vector3{0.0f, 0.02f, 0.0f}};
+    Math::Vector3 patch_colors[PATCH_SIDE_COUNT + 1]{Math::Vector3{0.3f, 0.2f, 0.1f}};
+    unsigned short patch_indexes[PATCH_SIDE_COUNT * 3]{};
+    for (std::uint32_t side_index{}; side_index < PATCH_SIDE_COUNT; ++side_index)
+    {
+        float angle{Math::TAU * static_cast<float>(side_index) / PATCH_SIDE_COUNT};
+        patch_positions[side_index + 1] =
+            position + Math::Vector3{radius * std::cos(angle), 0.02f, radius * std::sin(angle)};
+        patch_colors[side_index + 1] = Math::Vector3{0.25f, 0.17f, 0.08f};
+
+        // Clockwise seen from above
+        patch_indexes[side_index * 3] = 0;
+        patch_indexes[side_index * 3 + 1] = static_cast<unsigned short>((side_index + 1) % PATCH_SIDE_COUNT + 1);
+        patch_indexes[side_index * 3 + 2] = static_cast<unsigned short>(side_index + 1);
+    }
+
+    Gfx::create_elements_mesh(
+        patch_positions,
+        patch_colors,
+        nullptr,
+        nullptr,
+        PATCH_SIDE_COUNT + 1,
+        patch_indexes,
+        PATCH_SIDE_COUNT * 3,
+        Gfx::OGL::RenderingMode::TRIANGLES,
+        mesh_buffer,
+        draw_commands[0]
+    );
+
+    // Tapered blades of two base corners, two middle corners and a tip, on a golden angle spiral
+    std::vector<Math::Vector3> blade_positions{};
+    std::vector<Math::Vector3> blade_colors{};
+    std::vector<std::uint32_t> blade_indexes{};
+    blade_positions.reserve(BLADE_COUNT * 5);
+    blade_colors.reserve(BLADE_COUNT * 5);
+    blade_indexes.reserve(BLADE_COUNT * 9);
+    for (std::uint32_t blade_index{}; blade_index < BLADE_COUNT; ++blade_index)
+    {
+        float spiral_angle{GOLDEN_ANGLE * static_cast<float>(blade_index)};
+        float distance{0.95f * radius * std::sqrt((static_cast<float>(blade_index) + 0.5f) / BLADE_COUNT)};
+        Math::Vector3 root{
+            position + Math::Vector3{distance * std::cos(spiral_angle), 0.0f, distance * std::sin(spiral_angle)}
+        };
+        float facing_angle{7.0f * spiral_angle};
+        Math::Vector3 half_width{0.02f * std::cos(facing_angle), 0.0f, 0.02f * std::sin(facing_angle)};
+        float height{0.3f + 0.15f * std::sin(3.0f * spiral_angle + distance)};
+        Math::Vector3 lean{0.1f * std::sin(spiral_angle), 0.0f, 0.1f * std::cos(spiral_angle)};
+
+        auto first_index = static_cast<std::uint32_t>(blade_positions.size());
+        blade_positions.insert(
+            blade_positions.end(),
+            {root - half_width,
+             root + half_width,
+             root - half_width * 0.6f + lean * 0.3f + Math::Vector3{0.0f, height * 0.5f, 0.0f},
+             root + half_width * 0.6f + lean * 0.3f + Math::Vector3{0.0f, height * 0.5f, 0.0f},
+             root + lean + Math::Vector3{0.0f, height, 0.0f}}
+        );
+        blade_colors.insert(
+            blade_colors.end(),
+            {Math::Vector3{0.1f, 0.3f, 0.05f},
+             Math::Vector3{0.1f, 0.3f, 0.05f},
+             Math::Vector3{0.25f, 0.5f, 0.1f},
+             Math::Vector3{0.25f, 0.5f, 0.1f},
+             Math::Vector3{0.6f, 0.75f, 0.3f}}
+        );
+        blade_indexes.insert(
+            blade_indexes.end(),
+            {first_index,
+             first_index + 2,
+             first_index + 1,
+             first_index + 1,
+             first_index + 2,
+             first_index + 3,
+             first_index + 2,
+             first_index + 4,
+             first_index + 3}
+        );
+    }
+
+    Gfx::create_elements_mesh(
+        blade_positions.data(),
+        blade_colors.data(),
+        nullptr,
+        nullptr,
+        blade_positions.size(),
+        blade_indexes.data(),
+        blade_indexes.size(),
+        Gfx::OGL::RenderingMode::TRIANGLES,
+        mesh_buffer,
+        draw_commands[1]
+    );
+}
 } // namespace Game
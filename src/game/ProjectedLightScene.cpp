@@ -12,6 +12,7 @@
 #include "ErrorHandling.hpp"
 #include "Input.hpp"
 #include "Lighting.hpp"
+#include "OcclusionCulling.hpp"
 #include "OpenGL.hpp"
 #include "Path.hpp"
 #include "Rendering.hpp"
@@ -76,7 +77,7 @@ struct SpotlightShader : public Gfx::Shader
     Gfx::SamplerUniform spotlight_sampler{};
 
     SpotlightShader(GLuint shader_program)
-        : Gfx::Shader{shader_program, {.lv_normal_matrix = true}}
+        : Gfx::Shader{shader_program, {.lw_normal_matrix = true}}
         , light_block{Gfx::OGL::get_uniform_block_index(shader_program, "LightBlock")}
         , spotlight_block{Gfx::OGL::get_uniform_block_index(shader_program, "SpotlightBlock")}
         , sampler{Gfx::OGL::get_uniform_location(shader_program, "_texture")}
@@ -318,7 +319,6 @@ void ProjectedLightScene::init() const
             .orientation{Math::axis_angle_quaternion(Math::Vector3::right, Math::radians(-5.0f))},
             .scale{15.0f}
         },
-        Gfx::LocalToViewMatrix{},
         Gfx::MaterialRef{unlit_material_id},
         Gfx::MeshRef{space_axes_mesh_id},
         Gfx::Renderer{},
@@ -330,7 +330,7 @@ void ProjectedLightScene::init() const
         }
     );
 
-    Gfx::init_renderer(spotlight_id, Gfx::WITH_LV_MATRIX);
+    Gfx::init_renderer(spotlight_id, Gfx::WITH_LW_MATRIX);
 
     // Light group
     Core::create_entity(
@@ -360,20 +360,19 @@ void ProjectedLightScene::init() const
                 .orientation{Math::axis_angle_quaternion(Math::Vector3::right, Math::radians(-90.0f))},
                 .scale{47.0f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::PLANE_MESH_ID},
             Gfx::Renderer{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     // Diorama
     {
         auto mesh_id = next_mesh_id++;
         Gfx::create_mesh<1>(mesh_id, std::function{create_diorama_mesh});
+        create_diorama_occluder_mesh(mesh_id);
 
         auto material_id = next_material_id++;
         auto &material = Gfx::create_material<SpotlightMaterial>(material_id, spotlight_shader_id);
@@ -386,14 +385,13 @@ void ProjectedLightScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{.position{0.0f, -10.0f, 0.0f}, .scale{47.0f}},
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{mesh_id},
-            Gfx::Renderer{}
+            Gfx::Renderer{},
+            Gfx::Occluder{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     // Leaning bar
@@ -411,14 +409,12 @@ void ProjectedLightScene::init() const
             Core::Transform{
                 .position{3.0f, -7.0f, -10.0f}, .orientation{0.76604f, 0.64278f, 0.0f, 0.0f}, .scale{5.0f, 5.0f, 45.0f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     // Spinning bar
@@ -438,15 +434,13 @@ void ProjectedLightScene::init() const
                 .orientation{0.791242f, -0.148446f, 0.554035f, 0.212003f},
                 .scale{4.0f, 4.0f, 35.0f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
             RotationOverTime{.axis{Math::Vector3::backward}, .angle{1.0f}}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     // Right bar
@@ -462,14 +456,12 @@ void ProjectedLightScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{.position{13.0f, -2.0f, 0.0f}, .scale{4.0f, 4.0f, 10.0f}},
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 
     // Cube
@@ -485,15 +477,13 @@ void ProjectedLightScene::init() const
 
         auto id = Core::create_entity(
             Core::Transform{.position{0.0f, 1.0f, 0.0f}, .scale{3.0f}},
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
             RotationOverTime{.axis{Math::Vector3::up}, .angle{1.0f}}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX);
     }
 }
 
@@ -6,8 +6,8 @@ namespace Game
 {
 using namespace Age;
 
-FragmentLightingShader::FragmentLightingShader(GLuint shader_program)
-    : Shader{shader_program, {.lv_normal_matrix = true}}
+FragmentLightingShader::FragmentLightingShader(GLuint shader_program, Gfx::ShaderCommonUniforms common_uniforms)
+    : Shader{shader_program, common_uniforms}
     , light_block{Gfx::OGL::get_uniform_block_index(shader_program, "LightBlock")}
     , material_block{Gfx::OGL::get_uniform_block_index(shader_program, "MaterialBlock")}
     , gaussian_texture{Gfx::OGL::get_uniform_location(shader_program, "_gaussianTexture")}
@@ -1,8 +1,11 @@
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <span>
 #include <utility>
 #include <vector>
 
+#include "Blob.hpp"
 #include "DDS.hpp"
 #include "DefaultMaterials.hpp"
 #include "DefaultMeshes.hpp"
@@ -34,7 +37,7 @@ struct SphereImpostorShader : public Age::Gfx::Shader
     Gfx::UniformBlock materials_block{};
 
     SphereImpostorShader(GLuint shader_program)
-        : Shader{shader_program, {.lv_matrix = false}}
+        : Shader{shader_program, {.lw_matrix = false}}
         , light_block{Gfx::OGL::get_uniform_block_index(shader_program, "LightBlock")}
         , materials_block{Gfx::OGL::get_uniform_block_index(shader_program, "MaterialsBlock")}
     {
@@ -72,7 +75,7 @@ struct Sunlight
         Age::Math::Vector4 sky_color;
     };
 
-    std::vector<LightIntensity> light_intensities;
+    Age::Core::Blob<LightIntensity> light_intensities{};
     float day_length{};
     float time{};
     Age::Core::EntityId camera_id{};
@@ -86,8 +89,9 @@ void update_sunlight(Sunlight &sunlight, Core::Transform &transform, Gfx::Direct
         sunlight.time -= sunlight.day_length;
 
     float normalized_time{sunlight.time / sunlight.day_length};
+    std::span<Sunlight::LightIntensity> light_intensities{Core::get_blob_data(sunlight.light_intensities)};
     auto intensity_it_2 = std::find_if(
-        sunlight.light_intensities.cbegin(), sunlight.light_intensities.cend(), [=](const auto &light_intensity) {
+        light_intensities.begin(), light_intensities.end(), [=](const auto &light_intensity) {
             return normalized_time < light_intensity.normalized_time;
         }
     );
@@ -161,6 +165,104 @@ void control_material_via_keyboard(const MaterialKeyboardController &, const Gfx
         material.surface_shininess = std::clamp(material.surface_shininess - 0.01f, 0.01f, 1.0f);
 }
 
+constexpr std::uint32_t FIREFLY_COUNT{48};
+constexpr float FIREFLY_LIFE_TIME{4.0f};
+
+// Fireflies burn out and a new one is created further along their spiral
+struct Firefly
+{
+    static constexpr Age::Core::ComponentType TYPE{ComponentType::FIREFLY};
+
+    Gfx::MaterialId material_id{};
+    std::uint32_t spawn_index{};
+    float life_time{};
+};
+
+std::vector<Core::EntityId> s_burnt_out_firefly_ids{};
+
+void create_firefly(Gfx::MaterialId material_id, std::uint32_t spawn_index, float life_time)
+{
+    float spiral_position{static_cast<float>(spawn_index % FIREFLY_COUNT) / FIREFLY_COUNT};
+    float angle{Math::TAU * 2.5f * spiral_position + 0.3f * static_cast<float>(spawn_index / FIREFLY_COUNT)};
+    float radius{6.0f + 6.0f * spiral_position};
+    auto id = Core::create_entity(
+        Core::Transform{
+            .position{radius * std::cos(angle), 3.0f + 2.0f * std::sin(3.0f * angle), radius * std::sin(angle)},
+            .scale{0.08f}
+        },
+        Gfx::MaterialRef{material_id},
+        Gfx::MeshRef{Gfx::CUBE_MESH_ID},
+        Gfx::Renderer{},
+        Gfx::WorldBounds{},
+        Firefly{.material_id{material_id}, .spawn_index{spawn_index}, .life_time{life_time}}
+    );
+
+    Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM);
+}
+
+void burn_firefly(Core::EntityId entity_id, Firefly &firefly)
+{
+    firefly.life_time -= Time::delta_time();
+    if (firefly.life_time <= 0.0f)
+        s_burnt_out_firefly_ids.push_back(entity_id);
+    else
+        Gfx::set_renderer_active(entity_id, std::fmod(firefly.life_time, 1.0f) > 0.2f);
+}
+
+// The entities are destroyed once the components are no longer iterated
+void respawn_fireflies()
+{
+    Core::process_components(burn_firefly);
+
+    for (Core::EntityId entity_id : s_burnt_out_firefly_ids)
+    {
+        Firefly firefly{Core::get_entity_component<Firefly>(entity_id)};
+        Core::destroy_entity(entity_id);
+        create_firefly(firefly.material_id, firefly.spawn_index + FIREFLY_COUNT, FIREFLY_LIFE_TIME);
+    }
+    s_burnt_out_firefly_ids.clear();
+}
+
+// One stone after the other is raised and drawn as a lit cylinder
+struct StoneHighlight
+{
+    static constexpr Age::Core::ComponentType TYPE{ComponentType::STONE_HIGHLIGHT};
+
+    Age::Core::Blob<Age::Core::EntityId> stone_ids{};
+    Gfx::MaterialId stone_material_id{};
+    Gfx::MaterialId highlight_material_id{};
+    std::uint32_t stone_index{};
+    float time{};
+    float period{};
+};
+
+void set_stone_highlighted(Core::EntityId stone_id, const StoneHighlight &stone_highlight, bool is_highlighted)
+{
+    constexpr float HIGHLIGHT_HEIGHT{0.6f};
+
+    Gfx::set_renderer_material(
+        stone_id, is_highlighted ? stone_highlight.highlight_material_id : stone_highlight.stone_material_id
+    );
+    Gfx::set_renderer_mesh(stone_id, is_highlighted ? Gfx::CYLINDER_MESH_ID : Gfx::CUBE_MESH_ID);
+
+    Core::get_entity_component<Core::Transform>(stone_id).position.y += is_highlighted ? HIGHLIGHT_HEIGHT
+                                                                                        : -HIGHLIGHT_HEIGHT;
+    Gfx::mark_renderer_moved(stone_id);
+}
+
+void update_stone_highlight(StoneHighlight &stone_highlight)
+{
+    stone_highlight.time += Time::delta_time();
+    if (stone_highlight.time < stone_highlight.period)
+        return;
+    stone_highlight.time -= stone_highlight.period;
+
+    std::span<Core::EntityId> stone_ids{Core::get_blob_data(stone_highlight.stone_ids)};
+    set_stone_highlighted(stone_ids[stone_highlight.stone_index], stone_highlight, false);
+    stone_highlight.stone_index = (stone_highlight.stone_index + 1) % stone_ids.size();
+    set_stone_highlighted(stone_ids[stone_highlight.stone_index], stone_highlight, true);
+}
+
 void ValleyScene::init() const
 {
     Gfx::MeshId next_mesh_id{Gfx::USER_MESH_START_ID};
@@ -202,8 +304,44 @@ void ValleyScene::init() const
         };
         Gfx::create_shader<FragmentLightingColorShader>(fragment_lighting_color_shader, shader_assets);
     }
+    // The stones and the fireflies share their material and mesh, so they are drawn as instances
+    Gfx::ShaderId fragment_lighting_instanced_shader{next_shader_id++};
+    {
+        Gfx::ShaderAsset shader_assets[] = {
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::VERTEX, "shaders/fragment_lighting_instanced.vert"},
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::FRAGMENT, "shaders/fragment_lighting.frag"}
+        };
+        Gfx::create_shader<FragmentLightingShader>(
+            fragment_lighting_instanced_shader,
+            shader_assets,
+            Gfx::ShaderCommonUniforms{.lw_matrix = false, .instancing = true}
+        );
+    }
+    Gfx::ShaderId unlit_color_instanced_shader{next_shader_id++};
+    {
+        Gfx::ShaderAsset shader_assets[] = {
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::VERTEX, "shaders/unlit_color_instanced.vert"},
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::FRAGMENT, "shaders/unlit.frag"}
+        };
+        Gfx::create_shader<Gfx::UnlitColorShader>(
+            unlit_color_instanced_shader,
+            shader_assets,
+            Gfx::ShaderCommonUniforms{.lw_matrix = false, .instancing = true}
+        );
+    }
+
+    Gfx::ShaderId unlit_world_shader{next_shader_id++};
+    {
+        Gfx::ShaderAsset shader_assets[] = {
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::VERTEX, "shaders/unlit_world.vert"},
+            Gfx::ShaderAsset{Gfx::OGL::ShaderType::FRAGMENT, "shaders/unlit.frag"}
+        };
+        Gfx::create_shader<Gfx::UnlitShader>(
+            unlit_world_shader, shader_assets, Gfx::ShaderCommonUniforms{.lw_matrix = false}
+        );
+    }
 
-    auto material_buffer = Gfx::create_uniform_buffer<Gfx::MaterialBlock[4]>();
+    auto material_buffer = Gfx::create_uniform_buffer<Gfx::MaterialBlock[5]>();
     auto material_buffer_writer = Gfx::UniformBufferWriter<decltype(material_buffer)>{material_buffer};
 
     constexpr std::size_t TEXTURE_SIZE{512};
@@ -222,18 +360,14 @@ void ValleyScene::init() const
         gaussian_terms[index] = static_cast<GLubyte>(gaussian_term * 255.0f);
     }
 
+    int gaussian_texture_image_unit{1};
+
     GLuint gaussian_texture;
     glGenTextures(1, &gaussian_texture);
-    glBindTexture(GL_TEXTURE_1D, gaussian_texture);
+    Gfx::OGL::bind_texture(gaussian_texture_image_unit, GL_TEXTURE_1D, gaussian_texture);
     glTexImage1D(GL_TEXTURE_1D, 0, GL_R8, TEXTURE_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, gaussian_terms);
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAX_LEVEL, 0);
-    glBindTexture(GL_TEXTURE_1D, 0);
-
-    int gaussian_texture_image_unit{1};
-
-    glActiveTexture(GL_TEXTURE0 + gaussian_texture_image_unit);
-    glBindTexture(GL_TEXTURE_1D, gaussian_texture);
 
     GLuint gaussian_texture_sampler;
     glGenSamplers(1, &gaussian_texture_sampler);
@@ -241,7 +375,7 @@ void ValleyScene::init() const
     glSamplerParameteri(gaussian_texture_sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glSamplerParameteri(gaussian_texture_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 
-    glBindSampler(gaussian_texture_image_unit, gaussian_texture_sampler);
+    Gfx::OGL::bind_sampler(gaussian_texture_image_unit, gaussian_texture_sampler);
 
     // Light data
     std::vector<Math::Vector3> point_light_path_1{
@@ -342,11 +476,15 @@ void ValleyScene::init() const
     // Directional light 1
     Core::EntityId directional_light_id;
     {
-        directional_light_id = Core::create_entity(
+        directional_light_id = Core::reserve_entity_id();
+        Core::create_reserved_entity(
+            directional_light_id,
             Core::Transform{.position{Math::normalize(Math::Vector3{1.0f, 1.0f, -1.0f})}},
             Gfx::DirectionalLight{},
             Sunlight{
-                .light_intensities{sunlight_intensities},
+                .light_intensities{
+                    Core::create_blob<Sunlight::LightIntensity>(directional_light_id, sunlight_intensities)
+                },
                 .day_length{30.0f},
                 .time{5.0f},
                 .camera_id{camera_id},
@@ -361,22 +499,24 @@ void ValleyScene::init() const
         auto material_id = next_material_id++;
         Gfx::create_material<Gfx::UnlitColorMaterial>(material_id, unlit_color_shader);
 
-        point_light_1_id = Core::create_entity(
+        point_light_1_id = Core::reserve_entity_id();
+        Core::create_reserved_entity(
+            point_light_1_id,
             Core::Transform{.position{10.0f, 3.0f, 1.0f}, .scale{0.2f}},
-            Gfx::LocalToViewMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
+            Gfx::WorldBounds{},
             Gfx::PointLight{.light_intensity{0.6f, 0.6f, 0.6f, 1.0f}},
             Core::PathFollower{
-                .path{point_light_path_1},
+                .path{Core::create_blob<Math::Vector3>(point_light_1_id, point_light_path_1)},
                 .target_position{point_light_path_1[0]},
                 .move_speed{6.0f},
                 .repeat_path{true}
             }
         );
 
-        Gfx::init_renderer(point_light_1_id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(point_light_1_id, Gfx::WITH_LW_MATRIX | Gfx::WITH_WORLD_BOUNDS);
     }
 
     // Point light 2
@@ -386,26 +526,28 @@ void ValleyScene::init() const
         auto &material = Gfx::create_material<Gfx::UnlitColorMaterial>(material_id, unlit_color_shader);
         material.color = {0.0f, 0.0f, 1.0f};
 
-        point_light_2_id = Core::create_entity(
+        point_light_2_id = Core::reserve_entity_id();
+        Core::create_reserved_entity(
+            point_light_2_id,
             Core::Transform{
                 .position{-0.600002f, 6.20000f, 0.300000f},
                 .orientation{1.00000f, 0.00000f, 0.00000f, 0.00000f},
                 .scale{0.200000f, 0.200000f, 0.200000f}
             },
-            Gfx::LocalToViewMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
+            Gfx::WorldBounds{},
             Gfx::PointLight{.light_intensity{0.0f, 0.0f, 0.7f, 1.0f}},
             Core::PathFollower{
-                .path{point_light_path_2},
+                .path{Core::create_blob<Math::Vector3>(point_light_2_id, point_light_path_2)},
                 .target_position{point_light_path_2[0]},
                 .move_speed{7.0f},
                 .repeat_path{true}
             }
         );
 
-        Gfx::init_renderer(point_light_2_id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(point_light_2_id, Gfx::WITH_LW_MATRIX | Gfx::WITH_WORLD_BOUNDS);
     }
 
     // Point light 3
@@ -415,26 +557,28 @@ void ValleyScene::init() const
         auto &material = Gfx::create_material<Gfx::UnlitColorMaterial>(material_id, unlit_color_shader);
         material.color = {1.0f, 0.0f, 0.0f};
 
-        point_light_3_id = Core::create_entity(
+        point_light_3_id = Core::reserve_entity_id();
+        Core::create_reserved_entity(
+            point_light_3_id,
             Core::Transform{
                 .position{point_light_path_3[0]},
                 .orientation{1.00000f, 0.00000f, 0.00000f, 0.00000f},
                 .scale{0.200000f, 0.200000f, 0.200000f}
             },
-            Gfx::LocalToViewMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{Gfx::CUBE_MESH_ID},
             Gfx::Renderer{},
+            Gfx::WorldBounds{},
             Gfx::PointLight{.light_intensity{0.7f, 0.0f, 0.0f, 1.0f}},
             Core::PathFollower{
-                .path{point_light_path_3},
+                .path{Core::create_blob<Math::Vector3>(point_light_3_id, point_light_path_3)},
                 .target_position{point_light_path_3[1]},
                 .move_speed{5.0f},
                 .repeat_path{true}
             }
         );
 
-        Gfx::init_renderer(point_light_3_id, Gfx::WITH_LV_MATRIX);
+        Gfx::init_renderer(point_light_3_id, Gfx::WITH_LW_MATRIX | Gfx::WITH_WORLD_BOUNDS);
     }
 
     auto light_buffer = Gfx::create_uniform_buffer<Gfx::LightBlock>();
@@ -471,14 +615,16 @@ void ValleyScene::init() const
             Core::Transform{
                 .orientation{Math::axis_angle_quaternion({1.0f, 0.0f, 0.0f}, Math::radians(-90.0f))}, .scale{0.2f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{ground_mesh_id},
-            Gfx::Renderer{}
+            Gfx::Renderer{},
+            Gfx::WorldBounds{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(
+            id,
+            Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM
+        );
     }
 
     // Cylinder
@@ -500,14 +646,16 @@ void ValleyScene::init() const
                 .orientation{1.00000f, 0.00000f, 0.00000f, 0.00000f},
                 .scale{4.00000f, 4.00000f, 4.00000f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{mesh_id},
-            Gfx::Renderer{}
+            Gfx::Renderer{},
+            Gfx::WorldBounds{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(
+            id,
+            Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM
+        );
     }
 
     // Cube 1
@@ -527,14 +675,16 @@ void ValleyScene::init() const
                 .orientation{0.859259f, -0.268912f, -0.229626f, -0.369666f},
                 .scale{4.40000f, 4.40000f, 4.40000f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{mesh_id},
-            Gfx::Renderer{}
+            Gfx::Renderer{},
+            Gfx::WorldBounds{}
         );
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        Gfx::init_renderer(
+            id,
+            Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM
+        );
     }
 
     // Cube 2
@@ -554,14 +704,146 @@ void ValleyScene::init() const
                 .orientation{0.594317f, -0.573115f, -0.382432f, -0.414812f},
                 .scale{4.50000f, 4.40000f, 13.1000f}
             },
-            Gfx::LocalToViewMatrix{},
-            Gfx::LocalToViewNormalMatrix{},
             Gfx::MaterialRef{material_id},
             Gfx::MeshRef{mesh_id},
-            Gfx::Renderer{}
+            Gfx::Renderer{},
+            Gfx::WorldBounds{}
+        );
+
+        Gfx::init_renderer(
+            id,
+            Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM
         );
+    }
+
+    // Stones
+    {
+        constexpr std::size_t STONE_COUNT{96};
+        constexpr float STONE_RING_RADIUS{18.5f};
+
+        std::vector<Core::EntityId> stone_ids{};
 
-        Gfx::init_renderer(id, Gfx::WITH_LV_MATRIX | Gfx::WITH_LV_NORMAL_MATRIX);
+        auto material_id = next_material_id++;
+        auto &material =
+            Gfx::create_material<FragmentLightingMaterial>(material_id, fragment_lighting_instanced_shader);
+        material.light_buffer_range_id = light_buffer_range_id;
+        material.material_buffer_range_id = material_buffer.create_range(4, 1);
+        material.gaussian_texture = gaussian_texture_image_unit;
+
+        material_buffer_writer[4] = {.specular_color{0.1f, 0.1f, 0.1f, 1.0f}, .surface_shininess{0.3f}};
+
+        for (std::size_t index{}; index < STONE_COUNT; ++index)
+        {
+            float angle{Math::TAU * static_cast<float>(index) / STONE_COUNT};
+            auto id = Core::create_entity(
+                Core::Transform{
+                    .position{STONE_RING_RADIUS * std::cos(angle), 0.4f, STONE_RING_RADIUS * std::sin(angle)},
+                    .orientation{Math::axis_angle_quaternion(Math::Vector3::up, -angle)},
+                    .scale{0.6f, 0.8f + 0.4f * static_cast<float>(index % 3), 0.6f}
+                },
+                Gfx::MaterialRef{material_id},
+                Gfx::MeshRef{Gfx::CUBE_MESH_ID},
+                Gfx::Renderer{},
+                Gfx::WorldBounds{}
+            );
+
+            Gfx::init_renderer(
+                id,
+                Gfx::WITH_LW_MATRIX | Gfx::WITH_LW_NORMAL_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM
+            );
+            stone_ids.push_back(id);
+        }
+
+        auto highlight_material_id = next_material_id++;
+        auto &highlight_material =
+            Gfx::create_material<FragmentLightingColorMaterial>(highlight_material_id, fragment_lighting_color_shader);
+        highlight_material.light_buffer_range_id = light_buffer_range_id;
+        highlight_material.material_buffer_range_id = material_buffer.create_range(1, 1);
+        highlight_material.gaussian_texture = gaussian_texture_image_unit;
+        highlight_material.diffuse_color = {0.2f, 0.6f, 0.9f, 1.0f};
+
+        auto stone_highlight_id = Core::reserve_entity_id();
+        Core::create_reserved_entity(
+            stone_highlight_id,
+            StoneHighlight{
+                .stone_ids{Core::create_blob<Core::EntityId>(stone_highlight_id, stone_ids)},
+                .stone_material_id{material_id},
+                .highlight_material_id{highlight_material_id},
+                .period{0.25f}
+            }
+        );
+
+        const auto &stone_highlight = Core::get_entity_component<const StoneHighlight>(stone_highlight_id);
+        set_stone_highlighted(stone_ids[0], stone_highlight, true);
+    }
+
+    // Fireflies, the first ones burn out one after the other
+    {
+        auto material_id = next_material_id++;
+        auto &material = Gfx::create_material<Gfx::UnlitColorMaterial>(material_id, unlit_color_instanced_shader);
+        material.color = {1.0f, 0.9f, 0.3f};
+
+        for (std::uint32_t index{}; index < FIREFLY_COUNT; ++index)
+            create_firefly(material_id, index, FIREFLY_LIFE_TIME * static_cast<float>(index + 1) / FIREFLY_COUNT);
+    }
+
+    // Pollen, translucent so the cameras sort them back to front, enough of them to take the radix sort
+    {
+        constexpr std::uint32_t POLLEN_COUNT{512};
+        constexpr float GOLDEN_ANGLE{2.39996323f};
+
+        auto material_id = next_material_id++;
+        auto &material = Gfx::create_material<Gfx::UnlitColorMaterial>(material_id, unlit_color_instanced_shader);
+        material.color = {0.9f, 0.95f, 0.7f};
+
+        for (std::uint32_t index{}; index < POLLEN_COUNT; ++index)
+        {
+            float normalized_index{static_cast<float>(index) / POLLEN_COUNT};
+            float angle{GOLDEN_ANGLE * static_cast<float>(index)};
+            float radius{17.0f * std::sqrt(normalized_index)};
+            float height{1.0f + 5.0f * std::fmod(static_cast<float>(index) * 0.618034f, 1.0f)};
+            auto id = Core::create_entity(
+                Core::Transform{.position{radius * std::cos(angle), height, radius * std::sin(angle)}, .scale{0.03f}},
+                Gfx::MaterialRef{material_id},
+                Gfx::MeshRef{Gfx::CUBE_MESH_ID},
+                Gfx::Renderer{.is_translucent = true},
+                Gfx::WorldBounds{}
+            );
+
+            Gfx::init_renderer(id, Gfx::WITH_LW_MATRIX | Gfx::WITH_WORLD_BOUNDS | Gfx::WITH_STATIC_TRANSFORM);
+        }
+    }
+
+    // Waymarks, distinct meshes sharing their vertex buffers and drawn without per draw data,
+    // so their draws are merged into a single multi draw
+    {
+        constexpr std::size_t WAYMARK_COUNT{6};
+        constexpr float WAYMARK_RING_RADIUS{15.0f};
+
+        auto material_id = next_material_id++;
+        Gfx::create_material<Gfx::UnlitMaterial>(material_id, unlit_world_shader);
+
+        for (std::size_t index{}; index < WAYMARK_COUNT; ++index)
+        {
+            float angle{Math::TAU * (static_cast<float>(index) + 0.5f) / WAYMARK_COUNT};
+            auto mesh_id = next_mesh_id++;
+            Gfx::create_mesh<1>(
+                mesh_id,
+                std::function{create_waymark_mesh},
+                Math::Vector3{WAYMARK_RING_RADIUS * std::cos(angle), 0.0f, WAYMARK_RING_RADIUS * std::sin(angle)},
+                Math::Vector3{0.9f, 0.5f + 0.08f * static_cast<float>(index), 0.2f}
+            );
+
+            auto id = Core::create_entity(Gfx::MaterialRef{material_id}, Gfx::MeshRef{mesh_id}, Gfx::Renderer{});
+            Gfx::init_renderer(id);
+        }
+
+        // Meadow in the middle of the ring, its blades are indexed with 32 bits in the same buffers
+        auto mesh_id = next_mesh_id++;
+        Gfx::create_mesh<2>(mesh_id, std::function{create_meadow_mesh}, Math::Vector3{}, 3.0f);
+
+        auto id = Core::create_entity(Gfx::MaterialRef{material_id}, Gfx::MeshRef{mesh_id}, Gfx::Renderer{});
+        Gfx::init_renderer(id);
     }
 
     material_buffer_writer.apply();
@@ -622,6 +904,8 @@ void ValleyScene::update() const
     process_components(Core::move_along_path);
     process_components(update_sunlight);
     process_components(update_sphere_impostors);
+    respawn_fireflies();
+    process_components(update_stone_highlight);
 
     if (Gfx::has_framebuffer_size_changed())
         process_components(Gfx::update_perspective_camera_matrix);
@@ -1,3 +1,6 @@
+#include <charconv>
+#include <string_view>
+
 #include "MainLoop.hpp"
 
 #include "game/CheckerboardScene.hpp"
@@ -9,16 +12,41 @@
 #include "game/ProjectedLightScene.hpp"
 #include "game/ValleyScene.hpp"
 
-int main()
+namespace
+{
+// --headless renders offscreen, --frames N exits after N frames with a fixed delta time of 1/60 s
+Age::App::Definitions parse_arguments(int argc, char *argv[])
+{
+    Age::App::Definitions definitions{Game::g_definitions};
+    for (int index{1}; index < argc; ++index)
+    {
+        std::string_view argument{argv[index]};
+        if (argument == "--headless")
+            definitions.headless = true;
+        else if (argument == "--optimize-meshes")
+            definitions.optimize_meshes = true;
+        else if (argument == "--frames" && index + 1 < argc)
+        {
+            std::string_view value{argv[++index]};
+            std::from_chars(value.data(), value.data() + value.size(), definitions.frame_count);
+            definitions.fixed_delta_time = 1.0f / 60.0f;
+        }
+    }
+    return definitions;
+}
+} // namespace
+
+int main(int argc, char *argv[])
 {
     auto scene = Game::CubePointLightScene{};
+    auto definitions = parse_arguments(argc, argv);
 
 #ifdef _DEBUG
-    Age::Core::run_engine(Game::g_definitions, scene);
+    Age::Core::run_engine(definitions, scene);
 #else
     try
     {
-        Age::Core::run_engine(Game::g_definitions, scene);
+        Age::Core::run_engine(definitions, scene);
     }
     catch (const std::exception &e)
     {
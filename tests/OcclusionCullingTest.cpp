@@ -0,0 +1,114 @@
+// Checks that the occlusion buffer never reports a visible sphere as occluded:
+// a quad occluder faces the camera and random spheres are tested against it and against the exact geometry.
+// The quad is placed behind the near plane, where it hides part of the spheres, then in front of it,
+// where OpenGL clips it away and it hides nothing.
+// Built by tests/OcclusionCullingTest.vcxproj, it returns 1 when a visible sphere is culled.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "Math.hpp"
+#include "Matrix.hpp"
+#include "OcclusionCulling.hpp"
+#include "Transformations.hpp"
+#include "Vector.hpp"
+
+namespace
+{
+constexpr float QUAD_HALF_WIDTH{4.0f};
+constexpr float QUAD_HALF_HEIGHT{3.0f};
+constexpr float NEAR_PLANE_DISTANCE{0.1f};
+constexpr std::size_t SPHERE_COUNT{100'000};
+
+// The camera sits at the origin and looks down -z, so the world space is the view space.
+// A sphere is hidden by the quad when it lies behind the quad plane and inside the 4 planes
+// going through the camera and the quad edges. A quad in front of the near plane is clipped and hides nothing.
+bool is_sphere_behind_quad(float quad_distance, const Age::Math::Vector3 &center, float radius)
+{
+    if (quad_distance < NEAR_PLANE_DISTANCE || -center.z - radius <= quad_distance)
+        return false;
+
+    float x_normal_length{std::sqrt(quad_distance * quad_distance + QUAD_HALF_WIDTH * QUAD_HALF_WIDTH)};
+    float y_normal_length{std::sqrt(quad_distance * quad_distance + QUAD_HALF_HEIGHT * QUAD_HALF_HEIGHT)};
+    float x_distance{(-center.z * QUAD_HALF_WIDTH - std::abs(center.x) * quad_distance) / x_normal_length};
+    float y_distance{(-center.z * QUAD_HALF_HEIGHT - std::abs(center.y) * quad_distance) / y_normal_length};
+    return x_distance >= radius && y_distance >= radius;
+}
+
+// Returns the number of visible spheres reported as occluded
+std::size_t test_quad_occluder(float quad_distance)
+{
+    using namespace Age;
+
+    Gfx::OccluderMesh quad_mesh{
+        .vertex_positions{
+            {-QUAD_HALF_WIDTH, -QUAD_HALF_HEIGHT, -quad_distance},
+            {QUAD_HALF_WIDTH, -QUAD_HALF_HEIGHT, -quad_distance},
+            {QUAD_HALF_WIDTH, QUAD_HALF_HEIGHT, -quad_distance},
+            {-QUAD_HALF_WIDTH, QUAD_HALF_HEIGHT, -quad_distance}
+        },
+        .vertex_indices{0, 1, 2, 0, 2, 3}
+    };
+
+    Math::Matrix4 world_to_clip_matrix{Math::perspective_proj_matrix(
+        NEAR_PLANE_DISTANCE,
+        1000.0f,
+        static_cast<float>(Gfx::OCCLUSION_BUFFER_WIDTH) / static_cast<float>(Gfx::OCCLUSION_BUFFER_HEIGHT),
+        Math::radians(60.0f)
+    )};
+
+    Gfx::OcclusionBuffer occlusion_buffer{};
+    occlusion_buffer.begin(world_to_clip_matrix);
+    occlusion_buffer.add_occluder(Math::Matrix4{1.0f}, quad_mesh);
+    occlusion_buffer.rasterize();
+
+    std::mt19937 random_engine{42};
+    std::uniform_real_distribution<float> x_distribution{-30.0f, 30.0f};
+    std::uniform_real_distribution<float> y_distribution{-20.0f, 20.0f};
+    std::uniform_real_distribution<float> z_distribution{-100.0f, -1.0f};
+    std::uniform_real_distribution<float> radius_distribution{0.05f, 3.0f};
+
+    std::size_t hidden_sphere_count{};
+    std::size_t occluded_sphere_count{};
+    std::size_t false_occlusion_count{};
+    for (std::size_t index{}; index < SPHERE_COUNT; ++index)
+    {
+        Math::Vector3 center{
+            x_distribution(random_engine), y_distribution(random_engine), z_distribution(random_engine)
+        };
+        float radius{radius_distribution(random_engine)};
+
+        bool is_hidden{is_sphere_behind_quad(quad_distance, center, radius)};
+        bool is_occluded{occlusion_buffer.is_sphere_occluded(center, radius)};
+        hidden_sphere_count += is_hidden ? 1 : 0;
+        occluded_sphere_count += is_occluded ? 1 : 0;
+        if (is_occluded && !is_hidden)
+        {
+            ++false_occlusion_count;
+            std::printf(
+                "False occlusion of the sphere at (%f, %f, %f) of radius %f\n", center.x, center.y, center.z, radius
+            );
+        }
+    }
+
+    std::printf(
+        "Quad at %g: %zu spheres, %zu hidden by the quad, %zu culled, %zu false occlusions\n",
+        quad_distance,
+        SPHERE_COUNT,
+        hidden_sphere_count,
+        occluded_sphere_count,
+        false_occlusion_count
+    );
+    return false_occlusion_count;
+}
+} // namespace
+
+int main()
+{
+    std::size_t false_occlusion_count{test_quad_occluder(10.0f)};
+    false_occlusion_count += test_quad_occluder(0.05f);
+    return false_occlusion_count == 0 ? 0 : 1;
+}